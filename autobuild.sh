@@ -10,4 +10,7 @@ cd ..
 # Build test-rsa
 ./build_test-rsa.sh
 #run test
-./test-rsa.exe
\ No newline at end of file
+./test-rsa.exe
+# Build and run the bigint self-checks
+./build_test-bigint.sh
+./test-bigint.exe
\ No newline at end of file
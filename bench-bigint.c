@@ -0,0 +1,89 @@
+#include "bigint.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// bigint_mod_barrett against bigint_mod: the same 2k-word inputs (products
+// of two reduced values, the usual Barrett case) reduced by random 2048,
+// 3072 and 4096-bit moduli. Every result is also checked against bigint_mod.
+//
+//   bench-bigint [reductions per size]
+
+#define BENCH_INPUTS 64
+
+static double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// xorshift64*, fixed seed so every run reduces the same values
+static uint64_t rng_state = 0x2545F4914F6CDD1Du;
+static bigIntWord_t rng(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return (bigIntWord_t)(rng_state * 0x2545F4914F6CDD1Du);
+}
+
+int main(int argc, char **argv) {
+    size_t count = (argc > 1) ? strtoul(argv[1], NULL, 10) : 20000;
+    static const unsigned sizes[] = { 2048, 3072, 4096 };
+    static bigIntWord_t input_words[BENCH_INPUTS][BIGINT_MAX_WORDS];
+    bigInt_t inputs[BENCH_INPUTS];
+    int status = 0;
+    if (count == 0) count = 1;
+
+    printf("[INFO] %d-bit limbs, %zu reductions per size\n", BIGINT_WORD_BITS, count);
+    printf("modulus  bigint_mod  barrett   speedup\n");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        if (sizes[s] > BIGINT_MAX_MOD_BITS) break;
+        size_t k = BIGINT_WORDS_FOR_BITS(sizes[s]);
+
+        BIGINT_DEFINE(mod, BIGINT_MAX_MOD_WORDS);
+        for (size_t i = 0; i < k; i++) mod.words[i] = rng();
+        mod.words[k - 1] |= (bigIntWord_t)1 << (BIGINT_WORD_BITS - 1);
+        mod.length = (uint32_t)k;
+        bigIntBarrettCtx_t ctx;
+        if (bigint_barrett_init(&ctx, &mod) != BIGINT_OK) {
+            fprintf(stderr, "[ERROR] bigint_barrett_init failed for %u bits\n", sizes[s]);
+            return 1;
+        }
+        for (size_t n = 0; n < BENCH_INPUTS; n++) {
+            bigint_init(&inputs[n], input_words[n], BIGINT_MAX_WORDS);
+            for (size_t i = 0; i < 2 * k; i++) input_words[n][i] = rng();
+            inputs[n].length = (uint32_t)(2 * k);
+            bigint_normalize(&inputs[n]);
+        }
+
+        BIGINT_DEFINE(r1, BIGINT_MAX_MOD_WORDS);
+        BIGINT_DEFINE(r2, BIGINT_MAX_MOD_WORDS);
+        for (size_t n = 0; n < BENCH_INPUTS; n++) {
+            if (bigint_mod(&r1, &inputs[n], &mod) != BIGINT_OK ||
+                bigint_mod_barrett(&r2, &inputs[n], &ctx) != BIGINT_OK ||
+                bigint_compare(&r1, &r2) != 0) {
+                printf("[FAIL] %u-bit: bigint_mod_barrett differs from bigint_mod on input %zu\n", sizes[s], n);
+                status = 1;
+            }
+        }
+
+        // Best of three for each reducer
+        double best_mod = 0, best_barrett = 0;
+        for (int run = 0; run < 3; run++) {
+            double start = now();
+            for (size_t i = 0; i < count; i++) bigint_mod(&r1, &inputs[i % BENCH_INPUTS], &mod);
+            double elapsed = now() - start;
+            if (best_mod == 0 || elapsed < best_mod) best_mod = elapsed;
+
+            start = now();
+            for (size_t i = 0; i < count; i++) bigint_mod_barrett(&r2, &inputs[i % BENCH_INPUTS], &ctx);
+            elapsed = now() - start;
+            if (best_barrett == 0 || elapsed < best_barrett) best_barrett = elapsed;
+        }
+        printf("%7u  %7.2f us  %5.2f us  %6.2fx\n", sizes[s],
+               best_mod / count * 1e6, best_barrett / count * 1e6, best_mod / best_barrett);
+    }
+    return status;
+}
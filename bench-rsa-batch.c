@@ -0,0 +1,125 @@
+#include "rsa_keys.h"
+#include "rsa2048.h"
+#include "rsa_manifest.h"   // RSA_MANIFEST_HEADER_SIZE
+#include "rsa_pool.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+// Scaling of rsa_verify_batch: the same job list verified with 1, 2, 4, ...
+// pool threads. Jobs alternate between firmware.bin (hashing dominates) and
+// the signed manifest header (the RSA operation dominates), so the workers'
+// initial shares differ in cost and stealing has something to even out.
+//
+//   bench-rsa-batch [jobs] [max threads]
+
+// Reads a whole file, NULL if it cannot be opened
+static uint8_t *read_file(const char *path, size_t *size) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *data = malloc(*size ? *size : 1);
+    if (data && fread(data, 1, *size, f) != *size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    return data;
+}
+
+static double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+    size_t count = (argc > 1) ? strtoul(argv[1], NULL, 10) : 2000;
+    unsigned max_threads = (argc > 2) ? (unsigned)strtoul(argv[2], NULL, 10) : 0;
+    if (max_threads == 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        max_threads = (cpus > 0) ? (unsigned)cpus : 1;
+#else
+        max_threads = 1;
+#endif
+    }
+
+    size_t firmware_size, manifest_len, manifest_sig_len;
+    uint8_t *firmware = read_file("./genkey/firmware.bin", &firmware_size);
+    uint8_t *manifest = read_file("./genkey/manifest.bin", &manifest_len);
+    uint8_t *manifest_sig = read_file("./genkey/manifest.sig", &manifest_sig_len);
+    if (!firmware || count == 0) {
+        fprintf(stderr, "[ERROR] needs ./genkey/firmware.bin and a job count > 0\n");
+        return 1;
+    }
+    bool mixed = manifest && manifest_sig && manifest_len >= RSA_MANIFEST_HEADER_SIZE;
+
+    rsa_public_key_t key;
+    rsa_verify_job_t *jobs = malloc(count * sizeof(*jobs));
+    rsa_verify_result_t *results = malloc(count * sizeof(*results));
+    if (!jobs || !results || rsa_public_key_init(&key, rsa_modulus, RSA_KEY_SIZE, rsa_exponent) != RSA_VERIFY_OK) {
+        fprintf(stderr, "[ERROR] setup failed\n");
+        return 1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        jobs[i].key = &key;
+        if (mixed && (i & 1)) {
+            jobs[i].message = manifest;
+            jobs[i].message_len = RSA_MANIFEST_HEADER_SIZE;
+            jobs[i].signature = manifest_sig;
+            jobs[i].sig_len = manifest_sig_len;
+        } else {
+            jobs[i].message = firmware;
+            jobs[i].message_len = firmware_size;
+            jobs[i].signature = firmware_signature;
+            jobs[i].sig_len = SIGNATURE_SIZE;
+        }
+    }
+
+    printf("[INFO] %zu jobs (%s), up to %u threads\n", count,
+           mixed ? "firmware.bin / manifest header" : "firmware.bin", max_threads);
+    printf("threads  jobs/s      speedup  efficiency\n");
+    double base_rate = 0;
+    int status = 0;
+    for (unsigned threads = 1;; threads = (threads * 2 > max_threads && threads < max_threads) ? max_threads : threads * 2) {
+        rsa_verify_pool_t pool;
+        if (rsa_verify_pool_init(&pool, threads) != RSA_VERIFY_OK) {
+            fprintf(stderr, "[ERROR] pool with %u threads failed\n", threads);
+            return 1;
+        }
+        rsa_verify_batch(&pool, jobs, results, (count < 64) ? count : 64);   // warm-up
+
+        // Best of three
+        double best = 0;
+        for (int run = 0; run < 3; run++) {
+            double start = now();
+            rsa_verify_result_t result = rsa_verify_batch(&pool, jobs, results, count);
+            double elapsed = now() - start;
+            if (result != RSA_VERIFY_OK) {
+                printf("[FAIL] batch result %d\n", result);
+                status = 1;
+            }
+            if (best == 0 || elapsed < best) best = elapsed;
+        }
+        double rate = (double)count / best;
+        if (threads == 1) base_rate = rate;
+        printf("%7u  %10.0f  %7.2fx  %9.0f%%\n", pool.threads, rate, rate / base_rate,
+               100.0 * rate / base_rate / pool.threads);
+        rsa_verify_pool_free(&pool);
+        if (threads >= max_threads) break;
+    }
+
+    free(jobs);
+    free(results);
+    free(firmware);
+    free(manifest);
+    free(manifest_sig);
+    return status;
+}
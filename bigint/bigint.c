@@ -1,6 +1,24 @@
 #include "bigint.h"
+#include "bigint_simd.h"
 #include <string.h>
 #include <stdio.h>
+/**
+ * Attaches caller-owned storage to a big integer and sets it to zero.
+ * 
+ * @param a Pointer to the big integer to initialize.
+ * @param storage Word array that will hold the value (must outlive a).
+ * @param capacity Number of words in storage (at least 1).
+ * @return Status code indicating success, null pointer or invalid capacity.
+ */
+bigIntStatus_t bigint_init(bigInt_t *a, bigIntWord_t *storage, size_t capacity){
+  if(!a || !storage) return BIGINT_ERR_NULL;
+  if(capacity == 0 || capacity > UINT32_MAX) return BIGINT_ERR_INVALID;
+  a->words = storage;
+  a->capacity = (uint32_t)capacity;
+  a->words[0] = 0;
+  a->length = 1;
+  return BIGINT_OK;
+}
 /**
  * Sets the big integer to zero.
  * 
@@ -9,7 +27,7 @@
  */
 bigIntStatus_t bigint_zero(bigInt_t *a){
   if(!a) return BIGINT_ERR_NULL;
-  memset(a->words, 0, BIGINT_MAX_WORDS * BIGINT_WORD_BYTES);
+  a->words[0] = 0;
   a->length = 1;
   return BIGINT_OK;
 }
@@ -22,16 +40,50 @@ bigIntStatus_t bigint_zero(bigInt_t *a){
  */
 bigIntStatus_t bigint_from_uint32(bigInt_t *a, uint32_t val){
   if(!a) return BIGINT_ERR_NULL;
-  bigint_zero(a);
   a->words[0] = val;
-  if (val == 0) {
-    a->length = 1;  // Keep length = 1 for zero
-  } else {
-    a->length = 1;
-  }
+  a->length = 1;  // also the length of zero
   return BIGINT_OK;
 }
 
+// Big-endian word at p (BIGINT_WORD_BYTES bytes, any alignment): one load and
+// a byte swap on GCC/Clang little-endian targets
+static inline bigIntWord_t bigint_load_be(const uint8_t *p) {
+    bigIntWord_t w;
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__BYTE_ORDER__)
+    memcpy(&w, p, BIGINT_WORD_BYTES);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#if BIGINT_WORD_BITS == 64
+    w = __builtin_bswap64(w);
+#else
+    w = __builtin_bswap32(w);
+#endif
+#endif
+#else
+    w = 0;
+    for (int i = 0; i < BIGINT_WORD_BYTES; i++) w = (w << 8) | p[i];
+#endif
+    return w;
+}
+
+// Stores w big-endian at p (BIGINT_WORD_BYTES bytes, any alignment)
+static inline void bigint_store_be(uint8_t *p, bigIntWord_t w) {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__BYTE_ORDER__)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#if BIGINT_WORD_BITS == 64
+    w = __builtin_bswap64(w);
+#else
+    w = __builtin_bswap32(w);
+#endif
+#endif
+    memcpy(p, &w, BIGINT_WORD_BYTES);
+#else
+    for (int i = BIGINT_WORD_BYTES - 1; i >= 0; i--) {
+        p[i] = (uint8_t)w;
+        w >>= 8;
+    }
+#endif
+}
+
 /**
  * Loads a big integer from a big-endian byte array.
  * 
@@ -43,20 +95,31 @@ bigIntStatus_t bigint_from_uint32(bigInt_t *a, uint32_t val){
 // Essential for RSA: Load big integer from byte array (big-endian)
 bigIntStatus_t bigint_from_bytes(bigInt_t *a, const uint8_t *bytes, size_t byte_len) {
     if (!a || !bytes) return BIGINT_ERR_NULL;
-    if (byte_len > BIGINT_MAX_WORDS * 4) return BIGINT_ERR_OVERFLOW;
     
-    bigint_zero(a);
+    // Leading zero bytes beyond the capacity are fine, significant ones are not
+    while (byte_len > 0 && bytes[0] == 0) {
+        bytes++;
+        byte_len--;
+    }
+    if (byte_len > (size_t)a->capacity * BIGINT_WORD_BYTES) return BIGINT_ERR_OVERFLOW;
+    
+    if (byte_len == 0) return bigint_zero(a);
     
-    // Load bytes in big-endian order
-    for (size_t i = 0; i < byte_len; i++) {
-        size_t word_idx = (byte_len - 1 - i) / 4;
-        size_t byte_pos = (byte_len - 1 - i) % 4;
-        a->words[word_idx] |= ((uint32_t)bytes[i]) << (byte_pos * 8);
+    // Whole words from the end of the array, then the partial leading word
+    size_t full = byte_len / BIGINT_WORD_BYTES;
+    size_t partial = byte_len % BIGINT_WORD_BYTES;
+    const uint8_t *end = bytes + byte_len;
+    for (size_t i = 0; i < full; i++) {
+        a->words[i] = bigint_load_be(end - (i + 1) * BIGINT_WORD_BYTES);
+    }
+    if (partial) {
+        bigIntWord_t w = 0;
+        for (size_t i = 0; i < partial; i++) w = (w << 8) | bytes[i];
+        a->words[full] = w;
     }
     
-    // Set length
-    a->length = (byte_len + 3) / 4;
-    bigint_normalize(a);
+    // The leading byte is nonzero, so the top word is too
+    a->length = (uint32_t)(full + (partial != 0));
     
     return BIGINT_OK;
 }
@@ -72,25 +135,19 @@ bigIntStatus_t bigint_from_bytes(bigInt_t *a, const uint8_t *bytes, size_t byte_
 bigIntStatus_t bigint_to_bytes(const bigInt_t *a, uint8_t *bytes, size_t target_len) {
     if (!a || !bytes) return BIGINT_ERR_NULL;
     
-    // Initialize output buffer with zeros
-    memset(bytes, 0, target_len);
-    
     if (bigint_is_zero(a)) {
-        return BIGINT_OK;  // Already zero-filled
+        memset(bytes, 0, target_len);
+        return BIGINT_OK;
     }
     
-    // Calculate how many bytes we actually need
-    size_t actual_bytes_needed = 0;
-    for (int word_idx = a->length - 1; word_idx >= 0; word_idx--) {
-        uint32_t word = a->words[word_idx];
-        if (word_idx == a->length - 1) {
-            // For the most significant word, find the actual number of bytes
-            if (word & 0xFF000000) actual_bytes_needed = word_idx * 4 + 4;
-            else if (word & 0x00FF0000) actual_bytes_needed = word_idx * 4 + 3;
-            else if (word & 0x0000FF00) actual_bytes_needed = word_idx * 4 + 2;
-            else actual_bytes_needed = word_idx * 4 + 1;
-            break;
-        }
+    // Calculate how many bytes we actually need: full lower words plus the
+    // significant bytes of the most significant word
+    size_t top_idx = a->length - 1;
+    bigIntWord_t top = a->words[top_idx];
+    size_t actual_bytes_needed = top_idx * BIGINT_WORD_BYTES;
+    while (top) {
+        actual_bytes_needed++;
+        top >>= 8;
     }
     
     // Check if the number is too big for target length
@@ -98,20 +155,17 @@ bigIntStatus_t bigint_to_bytes(const bigInt_t *a, uint8_t *bytes, size_t target_
         return BIGINT_ERR_OVERFLOW;
     }
     
-    // Fill bytes from right to left (big-endian)
-    size_t byte_idx = target_len - 1;
-    
-    // Process each word from least significant to most significant
-    for (int word_idx = 0; word_idx < a->length && byte_idx < target_len; word_idx++) {
-        uint32_t word = a->words[word_idx];
-        
-        // Extract bytes from word (little-endian to big-endian conversion)
-        for (int byte_in_word = 0; byte_in_word < 4 && byte_idx < target_len; byte_in_word++) {
-            bytes[byte_idx] = (uint8_t)(word >> (byte_in_word * 8));
-            if (byte_idx == 0) break;  // Prevent underflow
-            byte_idx--;
-        }
+    // Whole words from the right (big-endian), then the significant bytes of
+    // the top word, then zero padding on the left
+    uint8_t *end = bytes + target_len;
+    for (size_t i = 0; i < top_idx; i++) {
+        bigint_store_be(end - (i + 1) * BIGINT_WORD_BYTES, a->words[i]);
     }
+    size_t pos = target_len - top_idx * BIGINT_WORD_BYTES;
+    for (bigIntWord_t w = a->words[top_idx]; w; w >>= 8) {
+        bytes[--pos] = (uint8_t)w;
+    }
+    memset(bytes, 0, pos);
     
     return BIGINT_OK;
 }
@@ -135,7 +189,9 @@ void bigint_normalize(bigInt_t *a) {
  */
 bigIntStatus_t bigint_copy(bigInt_t *dst, const bigInt_t *src){
   if (!dst || !src) return BIGINT_ERR_NULL;
-  memcpy(dst->words, src->words, BIGINT_WORD_BYTES * BIGINT_MAX_WORDS);
+  if (dst == src) return BIGINT_OK;
+  if (src->length > dst->capacity) return BIGINT_ERR_OVERFLOW;
+  memcpy(dst->words, src->words, BIGINT_WORD_BYTES * src->length);
   dst->length = src->length;
   return BIGINT_OK;
 }
@@ -147,7 +203,7 @@ bigIntStatus_t bigint_copy(bigInt_t *dst, const bigInt_t *src){
  */
 bool bigint_is_zero(const bigInt_t *a){
   if(!a) return true;
-  for(int i = 0; i < a->length ; ++i){
+  for(size_t i = 0; i < a->length ; ++i){
     if(a->words[i]) return false;
   }
   return true;
@@ -187,21 +243,21 @@ bigIntStatus_t bigint_add(bigInt_t *res, const bigInt_t *a, const bigInt_t *b) {
 
   size_t max_len = (a->length > b->length) ? a->length : b->length;
   // Check for potential overflow
-  if (max_len >= BIGINT_MAX_WORDS) return BIGINT_ERR_OVERFLOW;
+  if (max_len > res->capacity) return BIGINT_ERR_OVERFLOW;
   
-  uint32_t carry = 0;
+  bigIntWord_t carry = 0;
   size_t i;
   for (i = 0; i < max_len || carry; ++i) {
-      if (i >= BIGINT_MAX_WORDS) return BIGINT_ERR_OVERFLOW;
+      if (i >= res->capacity) return BIGINT_ERR_OVERFLOW;
       
-      uint32_t aw = (i < a->length) ? a->words[i] : 0;
-      uint32_t bw = (i < b->length) ? b->words[i] : 0;
+      bigIntWord_t aw = (i < a->length) ? a->words[i] : 0;
+      bigIntWord_t bw = (i < b->length) ? b->words[i] : 0;
       
-      uint64_t sum = (uint64_t)aw + bw + carry;  // Use 64-bit to detect overflow
-      res->words[i] = (uint32_t)sum;
-      carry = (uint32_t)(sum >> 32);
+      bigIntDword_t sum = (bigIntDword_t)aw + bw + carry;  // Use a double word to detect overflow
+      res->words[i] = (bigIntWord_t)sum;
+      carry = (bigIntWord_t)(sum >> BIGINT_WORD_BITS);
   }
-  res->length = i;
+  res->length = (uint32_t)i;
   return BIGINT_OK;
 }
 /**
@@ -219,21 +275,17 @@ bigIntStatus_t bigint_sub(bigInt_t *res, const bigInt_t *a, const bigInt_t *b) {
     if (bigint_compare(a, b) < 0) {
         return BIGINT_ERR_OVERFLOW; // or define a new error for negative results
     }
+    if (a->length > res->capacity) return BIGINT_ERR_OVERFLOW;
 
-    uint32_t borrow = 0;
+    bigIntWord_t borrow = 0;
     for (size_t i = 0; i < a->length; ++i) {
-        uint32_t aw = a->words[i];
-        uint32_t bw = (i < b->length) ? b->words[i] : 0;
+        bigIntWord_t aw = a->words[i];
+        bigIntWord_t bw = (i < b->length) ? b->words[i] : 0;
         
-        // Calculate difference with proper borrow handling
-        uint64_t diff = (uint64_t)aw - bw - borrow;
-        if (aw < bw + borrow) {
-            diff += 0x100000000ULL;  // Add 2^32 when borrowing
-            borrow = 1;
-        } else {
-            borrow = 0;
-        }
-        res->words[i] = (uint32_t)diff;
+        // Double-word difference: the top bit is set exactly when we borrowed
+        bigIntDword_t diff = (bigIntDword_t)aw - bw - borrow;
+        borrow = (bigIntWord_t)(diff >> (2 * BIGINT_WORD_BITS - 1));
+        res->words[i] = (bigIntWord_t)diff;
     }
     
     res->length = a->length;
@@ -242,6 +294,252 @@ bigIntStatus_t bigint_sub(bigInt_t *res, const bigInt_t *a, const bigInt_t *b) {
         res->length--;
     return BIGINT_OK;
 }
+// ---------------------------------------------------------------------------
+// Word-level multiplication kernels
+//
+// These work on raw little-endian word arrays; the output never aliases an
+// input. Operands at or above BIGINT_KARATSUBA_THRESHOLD words are split
+// recursively (Karatsuba), smaller ones use schoolbook loops.
+// ---------------------------------------------------------------------------
+
+// a[0..n) vs b[0..n): 1, 0 or -1
+static int bigint_words_cmp(const bigIntWord_t *a, const bigIntWord_t *b, size_t n) {
+    for (size_t i = n; i-- > 0;) {
+        if (a[i] != b[i]) return (a[i] > b[i]) ? 1 : -1;
+    }
+    return 0;
+}
+
+// r = a - b over n words, returns the final borrow
+static bigIntWord_t bigint_words_sub(bigIntWord_t *r, const bigIntWord_t *a, const bigIntWord_t *b, size_t n) {
+    bigIntWord_t borrow = 0;
+    for (size_t i = 0; i < n; i++) {
+        bigIntDword_t diff = (bigIntDword_t)a[i] - b[i] - borrow;
+        r[i] = (bigIntWord_t)diff;
+        borrow = (bigIntWord_t)(diff >> (2 * BIGINT_WORD_BITS - 1));
+    }
+    return borrow;
+}
+
+// leading zero bits of a nonzero word
+static unsigned bigint_clz(bigIntWord_t word) {
+    unsigned n = 0;
+    for (unsigned half = BIGINT_WORD_BITS / 2; half > 0; half /= 2) {
+        if (!(word >> (BIGINT_WORD_BITS - half))) {
+            word <<= half;
+            n += half;
+        }
+    }
+    return n;
+}
+
+// r = a << shift (shift < word bits) over n words, returns the bits shifted out
+static bigIntWord_t bigint_words_shl(bigIntWord_t *r, const bigIntWord_t *a, size_t n, unsigned shift) {
+    if (shift == 0) {
+        memmove(r, a, n * BIGINT_WORD_BYTES);
+        return 0;
+    }
+    bigIntWord_t out = a[n - 1] >> (BIGINT_WORD_BITS - shift);
+    for (size_t i = n - 1; i > 0; i--) {
+        r[i] = (a[i] << shift) | (a[i - 1] >> (BIGINT_WORD_BITS - shift));
+    }
+    r[0] = a[0] << shift;
+    return out;
+}
+
+// r = a >> shift (shift < word bits) over n words
+static void bigint_words_shr(bigIntWord_t *r, const bigIntWord_t *a, size_t n, unsigned shift) {
+    if (shift == 0) {
+        memmove(r, a, n * BIGINT_WORD_BYTES);
+        return;
+    }
+    for (size_t i = 0; i + 1 < n; i++) {
+        r[i] = (a[i] >> shift) | (a[i + 1] << (BIGINT_WORD_BITS - shift));
+    }
+    r[n - 1] = a[n - 1] >> shift;
+}
+
+// Number of significant bits of a normalized big integer
+static size_t bigint_bit_length(const bigInt_t *a) {
+    bigIntWord_t top = a->words[a->length - 1];
+    if (top == 0) return 0;
+    return a->length * BIGINT_WORD_BITS - bigint_clz(top);
+}
+
+// Bit i (0 = least significant) of a
+static unsigned bigint_get_bit(const bigInt_t *a, size_t i) {
+    return (unsigned)(a->words[i / BIGINT_WORD_BITS] >> (i % BIGINT_WORD_BITS)) & 1;
+}
+
+// r = a + b over n words, returns the final carry
+static bigIntWord_t bigint_words_add(bigIntWord_t *r, const bigIntWord_t *a, const bigIntWord_t *b, size_t n) {
+    bigIntWord_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        bigIntDword_t sum = (bigIntDword_t)a[i] + b[i] + carry;
+        r[i] = (bigIntWord_t)sum;
+        carry = (bigIntWord_t)(sum >> BIGINT_WORD_BITS);
+    }
+    return carry;
+}
+
+// r[0..n) += w, returns the carry out of the top word
+static bigIntWord_t bigint_words_add_word(bigIntWord_t *r, size_t n, bigIntWord_t w) {
+    for (size_t i = 0; i < n && w; i++) {
+        r[i] += w;
+        w = (r[i] < w);
+    }
+    return w;
+}
+
+// r[0..n) += a[0..n) * w, returns the carry word
+static bigIntWord_t bigint_words_addmul_1(bigIntWord_t *r, const bigIntWord_t *a, size_t n, bigIntWord_t w) {
+    bigIntWord_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        // (B-1)^2 + 2(B-1) still fits in a double word
+        bigIntDword_t sum = (bigIntDword_t)a[i] * w + r[i] + carry;
+        r[i] = (bigIntWord_t)sum;
+        carry = (bigIntWord_t)(sum >> BIGINT_WORD_BITS);
+    }
+    return carry;
+}
+
+// r[0..an+bn) = a * b, schoolbook
+static void bigint_words_mul_basecase(bigIntWord_t *r, const bigIntWord_t *a, size_t an,
+                                      const bigIntWord_t *b, size_t bn) {
+    memset(r, 0, (an + bn) * BIGINT_WORD_BYTES);
+    for (size_t i = 0; i < an; i++) {
+        if (a[i] == 0) continue; // Skip zero words
+        r[i + bn] = bigint_words_addmul_1(r + i, b, bn, a[i]);
+    }
+}
+
+// r[0..2n) = a * a: each cross product a[i]*a[j] (i < j) once, doubled,
+// then the diagonal squares added in
+static void bigint_words_sqr_basecase(bigIntWord_t *r, const bigIntWord_t *a, size_t n) {
+    memset(r, 0, 2 * n * BIGINT_WORD_BYTES);
+    for (size_t i = 0; i + 1 < n; i++) {
+        r[i + n] = bigint_words_addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+    }
+    bigint_words_shl(r, r, 2 * n, 1);
+
+    bigIntWord_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        bigIntDword_t sq = (bigIntDword_t)a[i] * a[i];
+        bigIntDword_t lo = (bigIntDword_t)r[2 * i] + (bigIntWord_t)sq + carry;
+        r[2 * i] = (bigIntWord_t)lo;
+        bigIntDword_t hi = (bigIntDword_t)r[2 * i + 1] + (bigIntWord_t)(sq >> BIGINT_WORD_BITS)
+                         + (bigIntWord_t)(lo >> BIGINT_WORD_BITS);
+        r[2 * i + 1] = (bigIntWord_t)hi;
+        carry = (bigIntWord_t)(hi >> BIGINT_WORD_BITS);
+    }
+}
+
+// r[0..hn) = |a[0..hn) - b[0..ln)| with ln <= hn, returns 1 if a < b
+static int bigint_words_absdiff(bigIntWord_t *r, const bigIntWord_t *a, size_t hn,
+                                const bigIntWord_t *b, size_t ln) {
+    bool a_high = false;
+    for (size_t i = ln; i < hn; i++) {
+        if (a[i]) a_high = true;
+    }
+    if (a_high || bigint_words_cmp(a, b, ln) >= 0) {
+        bigIntWord_t borrow = bigint_words_sub(r, a, b, ln);
+        for (size_t i = ln; i < hn; i++) {
+            r[i] = a[i] - borrow;
+            borrow = (a[i] < borrow);
+        }
+        return 0;
+    }
+    // a's words above ln are zero here
+    bigint_words_sub(r, b, a, ln);
+    memset(r + ln, 0, (hn - ln) * BIGINT_WORD_BYTES);
+    return 1;
+}
+
+/*
+ * Folds the Karatsuba middle term into r[0..2n): with z0 = r[0..2l) and
+ * z2 = r[2l..2n) already in place, adds (z0 + z2 -/+ d) << (l words), where
+ * d = |a1 - a0| * |b1 - b0| occupies 2h words.
+ */
+static void bigint_karatsuba_fold(bigIntWord_t *r, size_t n, size_t l, size_t h,
+                                  const bigIntWord_t *d, int d_negative, bigIntWord_t *t) {
+    // t = z0 + z2 over 2h + 1 words
+    memcpy(t, r, 2 * l * BIGINT_WORD_BYTES);
+    memset(t + 2 * l, 0, (2 * h + 1 - 2 * l) * BIGINT_WORD_BYTES);
+    t[2 * h] = bigint_words_add(t, t, r + 2 * l, 2 * h);
+
+    // (a1 - a0)(b1 - b0) = z2 - middle + z0, so middle = z0 + z2 - that product
+    if (d_negative) {
+        t[2 * h] += bigint_words_add(t, t, d, 2 * h);
+    } else {
+        t[2 * h] -= bigint_words_sub(t, t, d, 2 * h);
+    }
+
+    bigIntWord_t carry = bigint_words_add(r + l, r + l, t, 2 * h + 1);
+    bigint_words_add_word(r + l + 2 * h + 1, 2 * n - l - 2 * h - 1, carry);
+}
+
+// r[0..2n) = a * b for two n-word operands; t needs BIGINT_KARATSUBA_SCRATCH(n) words
+static void bigint_words_mul_n(bigIntWord_t *r, const bigIntWord_t *a, const bigIntWord_t *b,
+                               size_t n, bigIntWord_t *t) {
+    if (n < BIGINT_KARATSUBA_THRESHOLD) {
+        bigint_words_mul_basecase(r, a, n, b, n);
+        return;
+    }
+    size_t l = n / 2;   // low half
+    size_t h = n - l;   // high half, h >= l
+
+    bigint_words_mul_n(r, a, b, l, t);                  // z0 = a0 * b0
+    bigint_words_mul_n(r + 2 * l, a + l, b + l, h, t);  // z2 = a1 * b1
+
+    bigIntWord_t *da = t, *db = t + h, *d = t + 2 * h, *mid = t + 4 * h;
+    int neg = bigint_words_absdiff(da, a + l, h, a, l);
+    neg ^= bigint_words_absdiff(db, b + l, h, b, l);
+    bigint_words_mul_n(d, da, db, h, mid);
+    bigint_karatsuba_fold(r, n, l, h, d, neg, mid);
+}
+
+// r[0..2n) = a * a; t needs BIGINT_KARATSUBA_SCRATCH(n) words
+static void bigint_words_sqr_n(bigIntWord_t *r, const bigIntWord_t *a, size_t n, bigIntWord_t *t) {
+    if (n < BIGINT_KARATSUBA_THRESHOLD) {
+        bigint_words_sqr_basecase(r, a, n);
+        return;
+    }
+    size_t l = n / 2;
+    size_t h = n - l;
+
+    bigint_words_sqr_n(r, a, l, t);
+    bigint_words_sqr_n(r + 2 * l, a + l, h, t);
+
+    // (a1 - a0)^2 is never negative, so the middle term is z0 + z2 - d
+    bigIntWord_t *da = t, *d = t + 2 * h, *mid = t + 4 * h;
+    bigint_words_absdiff(da, a + l, h, a, l);
+    bigint_words_sqr_n(d, da, h, mid);
+    bigint_karatsuba_fold(r, n, l, h, d, 0, mid);
+}
+
+// r[0..an+bn) = a * b for any operand sizes
+static void bigint_words_mul(bigIntWord_t *r, const bigIntWord_t *a, size_t an,
+                             const bigIntWord_t *b, size_t bn) {
+    size_t lo = (an < bn) ? an : bn;
+    size_t hi = (an < bn) ? bn : an;
+
+    // Karatsuba only pays off for roughly balanced operands: pad the shorter
+    // one when it is at least 3/4 of the longer one
+    if (lo < BIGINT_KARATSUBA_THRESHOLD || 4 * lo < 3 * hi || 2 * hi > BIGINT_MAX_WORDS) {
+        bigint_words_mul_basecase(r, a, an, b, bn);
+        return;
+    }
+    bigIntWord_t ap[BIGINT_MAX_MOD_WORDS], bp[BIGINT_MAX_MOD_WORDS];
+    bigIntWord_t prod[BIGINT_MAX_WORDS];
+    bigIntWord_t t[BIGINT_KARATSUBA_SCRATCH(BIGINT_MAX_MOD_WORDS)];
+    memcpy(ap, a, an * BIGINT_WORD_BYTES);
+    memset(ap + an, 0, (hi - an) * BIGINT_WORD_BYTES);
+    memcpy(bp, b, bn * BIGINT_WORD_BYTES);
+    memset(bp + bn, 0, (hi - bn) * BIGINT_WORD_BYTES);
+    bigint_words_mul_n(prod, ap, bp, hi, t);
+    memcpy(r, prod, (an + bn) * BIGINT_WORD_BYTES);
+}
+
 /**
  * Multiplies two big integers and stores the result.
  * 
@@ -254,69 +552,74 @@ bigIntStatus_t bigint_mul(bigInt_t *res, const bigInt_t *a, const bigInt_t *b) {
     if (!res || !a || !b) return BIGINT_ERR_NULL;
     
     // Check for overflow TRƯỚC khi multiplication
-    if (a->length + b->length > BIGINT_MAX_WORDS) {
+    if (a->length + b->length > res->capacity || a->length + b->length > BIGINT_MAX_WORDS) {
         return BIGINT_ERR_OVERFLOW;
     }
     
-    bigint_zero(res);
-    
-    for (size_t i = 0; i < a->length; ++i) {
-        if (a->words[i] == 0) continue; // Skip zero words
-        
-        uint32_t carry = 0;
-        for (size_t j = 0; j < b->length; ++j) {
-            size_t pos = i + j;
-            if (pos >= BIGINT_MAX_WORDS) {
-                return BIGINT_ERR_OVERFLOW;
-            }
-            
-            uint64_t product = (uint64_t)a->words[i] * b->words[j];
-            uint64_t sum = (uint64_t)res->words[pos] + (uint32_t)product + carry;
-            res->words[pos] = (uint32_t)sum;
-            carry = (uint32_t)((product >> 32) + (sum >> 32));
-        }
-        
-        // Handle final carry
-        if (carry) {
-            size_t carry_pos = i + b->length;
-            if (carry_pos >= BIGINT_MAX_WORDS) {
-                return BIGINT_ERR_OVERFLOW;
-            }
-            res->words[carry_pos] = carry;
-        }
+    size_t len = a->length + b->length;
+    if (res == a || res == b) {
+        bigIntWord_t prod[BIGINT_MAX_WORDS];
+        bigint_words_mul(prod, a->words, a->length, b->words, b->length);
+        memcpy(res->words, prod, len * BIGINT_WORD_BYTES);
+    } else {
+        bigint_words_mul(res->words, a->words, a->length, b->words, b->length);
     }
     
-    res->length = a->length + b->length;
-    // Normalize
-    while (res->length > 1 && res->words[res->length - 1] == 0) {
-        res->length--;
+    res->length = (uint32_t)len;
+    bigint_normalize(res);
+    return BIGINT_OK;
+}
+/**
+ * Squares a big integer: res = a * a.
+ * 
+ * Each cross product is computed once and doubled, so this costs about half
+ * the word multiplications of bigint_mul(res, a, a).
+ * 
+ * @param res Pointer to output big integer (may alias a).
+ * @param a Pointer to the operand.
+ * @return Status code indicating success or overflow/null error.
+ */
+bigIntStatus_t bigint_sqr(bigInt_t *res, const bigInt_t *a) {
+    if (!res || !a) return BIGINT_ERR_NULL;
+    if (2 * a->length > res->capacity || 2 * a->length > BIGINT_MAX_WORDS) return BIGINT_ERR_OVERFLOW;
+
+    size_t n = a->length;
+    bigIntWord_t t[BIGINT_KARATSUBA_SCRATCH(BIGINT_MAX_MOD_WORDS)];
+    if (res == a) {
+        bigIntWord_t prod[BIGINT_MAX_WORDS];
+        bigint_words_sqr_n(prod, a->words, n, t);
+        memcpy(res->words, prod, 2 * n * BIGINT_WORD_BYTES);
+    } else {
+        bigint_words_sqr_n(res->words, a->words, n, t);
     }
-    
+
+    res->length = (uint32_t)(2 * n);
+    bigint_normalize(res);
     return BIGINT_OK;
 }
 
 // helper bigint_divmode
-static uint32_t bigint_div_word(uint64_t dividend, uint32_t divisor, uint32_t *remainder) {
+static bigIntWord_t bigint_div_word(bigIntDword_t dividend, bigIntWord_t divisor, bigIntWord_t *remainder) {
     if (divisor == 0) {
         *remainder = 0;
         return 0;
     }
-    *remainder = (uint32_t)(dividend % divisor);
-    return (uint32_t)(dividend / divisor);
+    *remainder = (bigIntWord_t)(dividend % divisor);
+    return (bigIntWord_t)(dividend / divisor);
 }
 
 // helper bigint_divmode
-static bigIntStatus_t bigint_div_word_inplace(bigInt_t *a, uint32_t divisor, uint32_t *remainder) {
+static bigIntStatus_t bigint_div_word_inplace(bigInt_t *a, bigIntWord_t divisor, bigIntWord_t *remainder) {
     if (!a || divisor == 0) return BIGINT_ERR_DIV_ZERO;
     
-    uint64_t carry = 0;
+    bigIntDword_t carry = 0;
     for (int i = (int)a->length - 1; i >= 0; i--) {
-        uint64_t dividend = (carry << 32) | a->words[i];
-        a->words[i] = (uint32_t)(dividend / divisor);
+        bigIntDword_t dividend = (carry << BIGINT_WORD_BITS) | a->words[i];
+        a->words[i] = (bigIntWord_t)(dividend / divisor);
         carry = dividend % divisor;
     }
     
-    if (remainder) *remainder = (uint32_t)carry;
+    if (remainder) *remainder = (bigIntWord_t)carry;
     
     // Normalize
     while (a->length > 1 && a->words[a->length - 1] == 0) {
@@ -325,6 +628,32 @@ static bigIntStatus_t bigint_div_word_inplace(bigInt_t *a, uint32_t divisor, uin
     
     return BIGINT_OK;
 }
+// helper bigint_divmod: floor((B^2 - 1) / d) - B for a normalized d (top bit set), B = 2^word bits
+static bigIntWord_t bigint_reciprocal(bigIntWord_t d) {
+    return (bigIntWord_t)((((bigIntDword_t)~d << BIGINT_WORD_BITS) | (bigIntWord_t)~(bigIntWord_t)0) / d);
+}
+
+/*
+ * helper bigint_divmod: (u1:u0) / d using the precomputed reciprocal of d
+ * (Moller & Granlund, "Improved division by invariant integers").
+ * Requires d normalized and u1 < d. Replaces the hardware double-word divide.
+ */
+static bigIntWord_t bigint_div_2by1(bigIntWord_t u1, bigIntWord_t u0, bigIntWord_t d, bigIntWord_t inv, bigIntWord_t *rem) {
+    bigIntDword_t q = (bigIntDword_t)inv * u1 + (((bigIntDword_t)u1 << BIGINT_WORD_BITS) | u0);
+    bigIntWord_t q1 = (bigIntWord_t)(q >> BIGINT_WORD_BITS) + 1;
+    bigIntWord_t q0 = (bigIntWord_t)q;
+    bigIntWord_t r = u0 - q1 * d;
+    if (r > q0) {
+        q1--;
+        r += d;
+    }
+    if (r >= d) {
+        q1++;
+        r -= d;
+    }
+    *rem = r;
+    return q1;
+}
 /**
  * Computes the quotient and remainder of num / den.
  * 
@@ -334,8 +663,6 @@ static bigIntStatus_t bigint_div_word_inplace(bigInt_t *a, uint32_t divisor, uin
  * @param den Pointer to denominator.
  * @return Status code indicating success, divide-by-zero, or overflow.
  */
-// Knuth's Algorithm 
-// I try to use subtraction method before but it's a bad idea. 
 bigIntStatus_t bigint_divmod(bigInt_t *quot, bigInt_t *rem, const bigInt_t *num, const bigInt_t *den) {
     if (!quot || !rem || !num || !den) return BIGINT_ERR_NULL;
     if (bigint_is_zero(den)) return BIGINT_ERR_DIV_ZERO;
@@ -358,101 +685,92 @@ bigIntStatus_t bigint_divmod(bigInt_t *quot, bigInt_t *rem, const bigInt_t *num,
         bigIntStatus_t status = bigint_copy(quot, num);
         if (status != BIGINT_OK) return status;
         
-        uint32_t remainder_word;
+        bigIntWord_t remainder_word;
         status = bigint_div_word_inplace(quot, den->words[0], &remainder_word);
         if (status != BIGINT_OK) return status;
         
-        return bigint_from_uint32(rem, remainder_word);
+        bigint_zero(rem);
+        rem->words[0] = remainder_word;
+        return BIGINT_OK;
     }
     
-    // General case: multi-word division using binary long division
-    
-    // Copy numerator to remainder
-    bigIntStatus_t status = bigint_copy(rem, num);
-    if (status != BIGINT_OK) return status;
-    
-    // Find the highest bit position in numerator
-    int num_bits = 0;
-    for (int i = (int)num->length - 1; i >= 0; i--) {
-        if (num->words[i] != 0) {
-            uint32_t word = num->words[i];
-            int word_bits = 32;
-            // Count leading zeros
-            if (word == 0) word_bits = 0;
-            else {
-                word_bits = 32;
-                if (!(word & 0xFFFF0000)) { word <<= 16; word_bits -= 16; }
-                if (!(word & 0xFF000000)) { word <<= 8; word_bits -= 8; }
-                if (!(word & 0xF0000000)) { word <<= 4; word_bits -= 4; }
-                if (!(word & 0xC0000000)) { word <<= 2; word_bits -= 2; }
-                if (!(word & 0x80000000)) { word <<= 1; word_bits -= 1; }
-            }
-            num_bits = i * 32 + word_bits;
-            break;
+    // General case: Knuth's Algorithm D (TAOCP vol. 2, 4.3.1), one quotient
+    // word per step. Both operands are normalized so the divisor's top bit is
+    // set, which keeps every estimated quotient word at most 2 too large.
+    size_t n = den->length;
+    size_t m = num->length - n;
+    if (num->length > BIGINT_MAX_WORDS) return BIGINT_ERR_OVERFLOW;
+    if (m + 1 > quot->capacity || n > rem->capacity) return BIGINT_ERR_OVERFLOW;
+    bigIntWord_t un[BIGINT_MAX_WORDS + 1];
+    bigIntWord_t vn[BIGINT_MAX_WORDS];
+
+    unsigned shift = bigint_clz(den->words[n - 1]);
+    bigint_words_shl(vn, den->words, n, shift);
+    un[num->length] = bigint_words_shl(un, num->words, num->length, shift);
+
+    bigIntWord_t d1 = vn[n - 1];
+    bigIntWord_t d0 = vn[n - 2];
+    bigIntWord_t inv = bigint_reciprocal(d1);
+
+    for (size_t j = m + 1; j-- > 0;) {
+        bigIntWord_t u2 = un[j + n];
+        bigIntWord_t u1 = un[j + n - 1];
+        bigIntWord_t u0 = un[j + n - 2];
+        bigIntWord_t qhat, rhat;
+        bool rhat_overflow = false;
+
+        if (u2 >= d1) {
+            // Only u2 == d1 is possible; the 2-by-1 step needs u2 < d1
+            qhat = ~(bigIntWord_t)0;
+            rhat = u1 + d1;
+            rhat_overflow = rhat < d1;
+        } else {
+            qhat = bigint_div_2by1(u2, u1, d1, inv, &rhat);
         }
-    }
-    
-    // Find the highest bit position in denominator
-    int den_bits = 0;
-    for (int i = (int)den->length - 1; i >= 0; i--) {
-        if (den->words[i] != 0) {
-            uint32_t word = den->words[i];
-            int word_bits = 32;
-            if (word == 0) word_bits = 0;
-            else {
-                word_bits = 32;
-                if (!(word & 0xFFFF0000)) { word <<= 16; word_bits -= 16; }
-                if (!(word & 0xFF000000)) { word <<= 8; word_bits -= 8; }
-                if (!(word & 0xF0000000)) { word <<= 4; word_bits -= 4; }
-                if (!(word & 0xC0000000)) { word <<= 2; word_bits -= 2; }
-                if (!(word & 0x80000000)) { word <<= 1; word_bits -= 1; }
-            }
-            den_bits = i * 32 + word_bits;
-            break;
+
+        // Refine the estimate with the second divisor word
+        while (!rhat_overflow &&
+               (bigIntDword_t)qhat * d0 > (((bigIntDword_t)rhat << BIGINT_WORD_BITS) | u0)) {
+            qhat--;
+            rhat += d1;
+            rhat_overflow = rhat < d1;
         }
-    }
-    
-    
-    if (num_bits < den_bits) {
-        // This shouldn't happen given our initial comparison, but be safe
-        return bigint_copy(rem, num);
-    }
-    
-    // Binary long division
-    for (int bit_pos = num_bits - den_bits; bit_pos >= 0; bit_pos--) {
-        // Create shifted divisor: den << bit_pos
-        bigInt_t shifted_den;
-        status = bigint_copy(&shifted_den, den);
-        if (status != BIGINT_OK) return status;
-        
-        if (bit_pos > 0) {
-            status = bigint_shift_left(&shifted_den, bit_pos);
-            if (status != BIGINT_OK) return status;
+
+        // un[j..j+n] -= qhat * vn
+        bigIntWord_t borrow = 0;
+        bigIntWord_t carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            bigIntDword_t prod = (bigIntDword_t)qhat * vn[i] + carry;
+            carry = (bigIntWord_t)(prod >> BIGINT_WORD_BITS);
+            bigIntDword_t diff = (bigIntDword_t)un[i + j] - (bigIntWord_t)prod - borrow;
+            un[i + j] = (bigIntWord_t)diff;
+            borrow = (bigIntWord_t)(diff >> (2 * BIGINT_WORD_BITS - 1));
         }
-        
-        // If remainder >= shifted_den, subtract it and set quotient bit
-        if (bigint_compare(rem, &shifted_den) >= 0) {
-            status = bigint_sub(rem, rem, &shifted_den);
-            if (status != BIGINT_OK) return status;
-            
-            // Set bit in quotient
-            size_t word_pos = bit_pos / 32;
-            size_t bit_in_word = bit_pos % 32;
-            
-            if (word_pos >= BIGINT_MAX_WORDS) return BIGINT_ERR_OVERFLOW;
-            
-            quot->words[word_pos] |= (1U << bit_in_word);
-            if (word_pos >= quot->length) {
-                quot->length = word_pos + 1;
+        bigIntDword_t diff = (bigIntDword_t)un[j + n] - carry - borrow;
+        un[j + n] = (bigIntWord_t)diff;
+
+        // Estimate was still one too large (probability ~2/B): add back
+        if (diff >> (2 * BIGINT_WORD_BITS - 1)) {
+            qhat--;
+            bigIntWord_t c = 0;
+            for (size_t i = 0; i < n; i++) {
+                bigIntDword_t sum = (bigIntDword_t)un[i + j] + vn[i] + c;
+                un[i + j] = (bigIntWord_t)sum;
+                c = (bigIntWord_t)(sum >> BIGINT_WORD_BITS);
             }
+            un[j + n] += c;
         }
+        quot->words[j] = qhat;
     }
-    
-    // Normalize quotient
-    while (quot->length > 1 && quot->words[quot->length - 1] == 0) {
-        quot->length--;
-    }
-    
+    quot->length = (uint32_t)(m + 1);
+    bigint_normalize(quot);
+
+    // Remainder is the low n words, shifted back
+    bigint_zero(rem);
+    bigint_words_shr(rem->words, un, n, shift);
+    rem->length = (uint32_t)n;
+    bigint_normalize(rem);
+
     return BIGINT_OK;
 }
 /**
@@ -467,7 +785,10 @@ bigIntStatus_t bigint_mod(bigInt_t *res, const bigInt_t *a, const bigInt_t *m) {
     if (!res || !a || !m) return BIGINT_ERR_NULL;
     if (bigint_is_zero(m)) return BIGINT_ERR_DIV_ZERO;
     
+    bigIntWord_t quot_words[BIGINT_MAX_WORDS], rem_words[BIGINT_MAX_WORDS];
     bigInt_t quot, rem;
+    bigint_init(&quot, quot_words, BIGINT_MAX_WORDS);
+    bigint_init(&rem, rem_words, BIGINT_MAX_WORDS);
     bigIntStatus_t status = bigint_divmod(&quot, &rem, a, m);
     if (status != BIGINT_OK) return status;
     
@@ -483,12 +804,12 @@ bigIntStatus_t bigint_mod(bigInt_t *res, const bigInt_t *a, const bigInt_t *m) {
 bigIntStatus_t bigint_shift_left(bigInt_t *a, size_t bits) {
     if (!a) return BIGINT_ERR_NULL;
 
-    size_t word_shift = bits / 32;
-    size_t bit_shift = bits % 32;
+    size_t word_shift = bits / BIGINT_WORD_BITS;
+    size_t bit_shift = bits % BIGINT_WORD_BITS;
 
     // Check overflow for word shift
     if (word_shift > 0) {
-        if (a->length + word_shift > BIGINT_MAX_WORDS) {
+        if (a->length + word_shift > a->capacity) {
             return BIGINT_ERR_OVERFLOW;
         }
         
@@ -505,15 +826,15 @@ bigIntStatus_t bigint_shift_left(bigInt_t *a, size_t bits) {
 
     // Bit shift within words
     if (bit_shift > 0) {
-        uint32_t carry = 0;
+        bigIntWord_t carry = 0;
         for (size_t i = 0; i < a->length; ++i) {
-            uint32_t new_carry = a->words[i] >> (32 - bit_shift);
+            bigIntWord_t new_carry = a->words[i] >> (BIGINT_WORD_BITS - bit_shift);
             a->words[i] = (a->words[i] << bit_shift) | carry;
             carry = new_carry;
         }
         // Handle final carry
         if (carry) {
-            if (a->length >= BIGINT_MAX_WORDS) {
+            if (a->length >= a->capacity) {
                 return BIGINT_ERR_OVERFLOW;
             }
             a->words[a->length++] = carry;
@@ -532,8 +853,8 @@ bigIntStatus_t bigint_shift_left(bigInt_t *a, size_t bits) {
 bigIntStatus_t bigint_shift_right(bigInt_t *a, size_t bits) {
   if (!a) return BIGINT_ERR_NULL;
 
-  size_t word_shift = bits / 32;
-  size_t bit_shift = bits % 32;
+  size_t word_shift = bits / BIGINT_WORD_BITS;
+  size_t bit_shift = bits % BIGINT_WORD_BITS;
 
   if (word_shift >= a->length) {
       return bigint_zero(a);
@@ -542,18 +863,14 @@ bigIntStatus_t bigint_shift_right(bigInt_t *a, size_t bits) {
   // Shift words
   for (size_t i = 0; i < a->length - word_shift; ++i)
       a->words[i] = a->words[i + word_shift];
-  
-  // Clear upper words
-  for (size_t i = a->length - word_shift; i < a->length; ++i)
-      a->words[i] = 0;
       
   a->length -= word_shift;
   
   // Bit shift within words
   if (bit_shift > 0) {
-    uint32_t carry = 0;
+    bigIntWord_t carry = 0;
     for (int i = (int)a->length - 1; i >= 0; --i) {
-        uint32_t new_carry = a->words[i] << (32 - bit_shift);
+        bigIntWord_t new_carry = a->words[i] << (BIGINT_WORD_BITS - bit_shift);
         a->words[i] = (a->words[i] >> bit_shift) | carry;
         carry = new_carry;
     }
@@ -577,17 +894,32 @@ bigIntStatus_t bigint_mod_exp(bigInt_t *res, const bigInt_t *base, const bigInt_
     if (!res || !base || !exp || !mod) return BIGINT_ERR_NULL;
     if (bigint_is_zero(mod)) return BIGINT_ERR_DIV_ZERO;
     
+    bigIntStatus_t status;
+
+    // Odd moduli (every RSA modulus) take the Montgomery path: no division per step
+    if (mod->words[0] & 1) {
+        bigIntMontCtx_t ctx;
+        status = bigint_mont_init(&ctx, mod);
+        if (status != BIGINT_OK) return status;
+        return bigint_mont_exp(res, base, exp, &ctx);
+    }
+
     // Check if BIGINT_MAX_WORDS is sufficient
     if (mod->length * 2 > BIGINT_MAX_WORDS) {
         return BIGINT_ERR_OVERFLOW;
     }
     
-    bigInt_t result, b, e;
-    bigIntStatus_t status;
+    bigIntWord_t result_words[BIGINT_MAX_WORDS], b_words[BIGINT_MAX_WORDS], temp_words[BIGINT_MAX_WORDS];
+    bigInt_t result, b, temp;
+    bigint_init(&result, result_words, BIGINT_MAX_WORDS);
+    bigint_init(&b, b_words, BIGINT_MAX_WORDS);
+    bigint_init(&temp, temp_words, BIGINT_MAX_WORDS);
     
-    // Initialize result = 1
+    // Initialize result = 1 (mod 1 is 0)
     status = bigint_from_uint32(&result, 1);
     if (status != BIGINT_OK) return status;
+    status = bigint_mod(&result, &result, mod);
+    if (status != BIGINT_OK) return status;
     
     // Reduce base modulo mod first (quan trọng cho RSA)
     status = bigint_mod(&b, base, mod);
@@ -595,49 +927,773 @@ bigIntStatus_t bigint_mod_exp(bigInt_t *res, const bigInt_t *base, const bigInt_
         return status;
     }
     
-    status = bigint_copy(&e, exp);
-    if (status != BIGINT_OK) return status;
-    
-    // Binary exponentiation
-    int iteration = 0;
-    const int MAX_ITERATIONS = 32 * exp->length; // Realistic limit
-    
-    while (!bigint_is_zero(&e) && iteration < MAX_ITERATIONS) {
-        if (e.words[0] & 1) {  // If exp is odd
-            bigInt_t temp;
+    // Left-to-right binary exponentiation, reading exponent bits in place
+    for (size_t i = bigint_bit_length(exp); i-- > 0;) {
+        status = bigint_sqr(&temp, &result);
+        if (status != BIGINT_OK) return status;
+        status = bigint_mod(&result, &temp, mod);
+        if (status != BIGINT_OK) return status;
+        
+        if (bigint_get_bit(exp, i)) {
             status = bigint_mul(&temp, &result, &b);
-            if (status != BIGINT_OK) {
-                return status;
-            }
-            
+            if (status != BIGINT_OK) return status;
             status = bigint_mod(&result, &temp, mod);
-            if (status != BIGINT_OK) {
-                return status;
-            }
+            if (status != BIGINT_OK) return status;
         }
-        
-        // Square base and reduce
-        bigInt_t temp;
-        status = bigint_mul(&temp, &b, &b);
-        if (status != BIGINT_OK) {
-            return status;
+    }
+    
+    return bigint_copy(res, &result);
+}
+
+// ---------------------------------------------------------------------------
+// Barrett reduction
+//
+// For reductions outside the Montgomery domain (one-off a mod m, key checks):
+// with mu precomputed once, x mod m for x < B^2k costs two half products and
+// a few subtractions instead of a long division (HAC 14.42).
+// ---------------------------------------------------------------------------
+
+// r[0..n) = (a * b) mod B^n, only the columns below n are computed
+static void bigint_words_mul_lo(bigIntWord_t *r, const bigIntWord_t *a, size_t an,
+                                const bigIntWord_t *b, size_t bn, size_t n) {
+    memset(r, 0, n * BIGINT_WORD_BYTES);
+    for (size_t i = 0; i < an && i < n; i++) {
+        size_t len = (bn < n - i) ? bn : n - i;
+        bigIntWord_t carry = bigint_words_addmul_1(r + i, b, len, a[i]);
+        if (len == bn && i + bn < n) r[i + bn] = carry;
+    }
+}
+
+// r[0..an+bn) = a * b without the partial products below column `from`;
+// the low words are garbage and the high ones may lack those carries
+static void bigint_words_mul_hi(bigIntWord_t *r, const bigIntWord_t *a, size_t an,
+                                const bigIntWord_t *b, size_t bn, size_t from) {
+    memset(r, 0, (an + bn) * BIGINT_WORD_BYTES);
+    for (size_t i = 0; i < an; i++) {
+        size_t j = (from > i) ? from - i : 0;
+        if (j >= bn) continue;
+        r[i + bn] = bigint_words_addmul_1(r + i + j, b + j, bn - j, a[i]);
+    }
+}
+
+/**
+ * Precomputes the Barrett constant mu = floor((B^2k - 1) / m) for a k-word modulus.
+ * 
+ * Using B^2k - 1 rather than B^2k keeps the numerator within BIGINT_MAX_WORDS;
+ * mu is then at most one too small, which costs one more final subtraction.
+ * 
+ * @param ctx Pointer to the context to fill.
+ * @param mod Pointer to the modulus (nonzero, at most BIGINT_MAX_MOD_WORDS words).
+ * @return Status code indicating success, divide-by-zero, overflow or null error.
+ */
+bigIntStatus_t bigint_barrett_init(bigIntBarrettCtx_t *ctx, const bigInt_t *mod) {
+    if (!ctx || !mod) return BIGINT_ERR_NULL;
+    if (bigint_is_zero(mod)) return BIGINT_ERR_DIV_ZERO;
+    if (mod->length > BIGINT_MAX_MOD_WORDS) return BIGINT_ERR_OVERFLOW;
+
+    size_t k = mod->length;
+    bigIntWord_t num_words[BIGINT_MAX_WORDS];
+    bigIntWord_t rem_words[BIGINT_MAX_MOD_WORDS];
+    bigInt_t num, quot, rem;
+    bigint_init(&num, num_words, BIGINT_MAX_WORDS);
+    bigint_init(&quot, ctx->mu, BIGINT_MAX_MOD_WORDS + 1);
+    bigint_init(&rem, rem_words, BIGINT_MAX_MOD_WORDS);
+
+    memset(num_words, 0xFF, 2 * k * BIGINT_WORD_BYTES);
+    num.length = (uint32_t)(2 * k);
+    bigIntStatus_t status = bigint_divmod(&quot, &rem, &num, mod);
+    if (status != BIGINT_OK) return status;
+
+    memcpy(ctx->m, mod->words, k * BIGINT_WORD_BYTES);
+    ctx->length = (uint32_t)k;
+    ctx->mu_length = quot.length;
+    return BIGINT_OK;
+}
+
+/**
+ * Reduces a big integer with a precomputed Barrett context: res = a mod m.
+ * 
+ * Inputs up to 2k words (any product of two reduced values) take the Barrett
+ * path; longer ones fall back to bigint_mod.
+ * 
+ * @param res Pointer to output big integer (may alias a).
+ * @param a Pointer to the value to reduce.
+ * @param ctx Pointer to an initialized Barrett context.
+ * @return Status code indicating success or error.
+ */
+bigIntStatus_t bigint_mod_barrett(bigInt_t *res, const bigInt_t *a, const bigIntBarrettCtx_t *ctx) {
+    if (!res || !a || !ctx) return BIGINT_ERR_NULL;
+
+    size_t k = ctx->length;
+    bigInt_t m = { (bigIntWord_t *)ctx->m, ctx->length, BIGINT_MAX_MOD_WORDS };
+    if (a->length > 2 * k) return bigint_mod(res, a, &m);
+    if (bigint_compare(a, &m) < 0) return bigint_copy(res, a);
+
+    // q3 = floor(floor(a / B^(k-1)) * mu / B^(k+1)), the quotient estimate.
+    // Columns below k-1 of the product are skipped: together they are less
+    // than B^(k+1), so q3 is at most 4 below the true quotient
+    bigIntWord_t q[2 * BIGINT_MAX_MOD_WORDS + 2];
+    const bigIntWord_t *q1 = a->words + (k - 1);
+    size_t q1_len = a->length - (k - 1);
+    size_t q2_len = q1_len + ctx->mu_length;
+    bigint_words_mul_hi(q, q1, q1_len, ctx->mu, ctx->mu_length, k - 1);
+
+    // r = (a - q3 * m) mod B^(k+1); the true remainder is r - j*m for j <= 4,
+    // and 5m < B^(k+1), so the low k+1 words are exact
+    bigIntWord_t r[BIGINT_MAX_MOD_WORDS + 1];
+    size_t rn = k + 1;
+    memset(r, 0, rn * BIGINT_WORD_BYTES);
+    memcpy(r, a->words, ((a->length < rn) ? a->length : rn) * BIGINT_WORD_BYTES);
+    if (q2_len > rn) {
+        bigIntWord_t qm[BIGINT_MAX_MOD_WORDS + 1];
+        bigint_words_mul_lo(qm, q + rn, q2_len - rn, ctx->m, k, rn);
+        bigint_words_sub(r, r, qm, rn);
+    }
+
+    // At most four corrections
+    bigIntWord_t mp[BIGINT_MAX_MOD_WORDS + 1];
+    memcpy(mp, ctx->m, k * BIGINT_WORD_BYTES);
+    mp[k] = 0;
+    while (bigint_words_cmp(r, mp, rn) >= 0) {
+        bigint_words_sub(r, r, mp, rn);
+    }
+
+    while (rn > 1 && r[rn - 1] == 0) rn--;
+    if (rn > res->capacity) return BIGINT_ERR_OVERFLOW;
+    memcpy(res->words, r, rn * BIGINT_WORD_BYTES);
+    res->length = (uint32_t)rn;
+    return BIGINT_OK;
+}
+
+// ---------------------------------------------------------------------------
+// Montgomery arithmetic
+//
+// Values in the Montgomery domain are kept as exactly k = ctx->length words so the
+// inner loops never have to look at bigInt_t lengths. Every product is reduced
+// word by word (CIOS), so an exponentiation never calls bigint_divmod.
+// ---------------------------------------------------------------------------
+
+// Copies a into k words, zero-filling above a->length
+static void bigint_mont_load(bigIntWord_t *dst, const bigInt_t *a, size_t k) {
+    memcpy(dst, a->words, a->length * BIGINT_WORD_BYTES);
+    memset(dst + a->length, 0, (k - a->length) * BIGINT_WORD_BYTES);
+}
+
+// Stores k words into res, normalized; fails if res cannot hold the value
+static bigIntStatus_t bigint_mont_store(bigInt_t *res, const bigIntWord_t *src, size_t k) {
+    while (k > 1 && src[k - 1] == 0) k--;
+    if (k > res->capacity) return BIGINT_ERR_OVERFLOW;
+    bigint_zero(res);
+    memcpy(res->words, src, k * BIGINT_WORD_BYTES);
+    res->length = (uint32_t)k;
+    return BIGINT_OK;
+}
+
+// Read-only bigInt_t view of the context modulus, for compare/mod
+static bigInt_t bigint_mont_modulus(const bigIntMontCtx_t *ctx) {
+    bigInt_t n = { (bigIntWord_t *)ctx->n, ctx->length, BIGINT_MAX_MOD_WORDS };
+    return n;
+}
+
+// True if a is a valid Montgomery-domain operand (a < n)
+static bool bigint_mont_reduced(const bigInt_t *a, const bigIntMontCtx_t *ctx) {
+    bigInt_t n = bigint_mont_modulus(ctx);
+    return bigint_compare(a, &n) < 0;
+}
+
+/*
+ * r = a * b * R^-1 mod n over k words (a, b < n), interleaved product and
+ * reduction (CIOS). r may alias a or b; t needs k + 2 words.
+ */
+static void bigint_mont_mul_cios(bigIntWord_t *r, const bigIntWord_t *a, const bigIntWord_t *b,
+                                  const bigIntWord_t *n, bigIntWord_t n0inv, size_t k, bigIntWord_t *t) {
+    memset(t, 0, (k + 2) * BIGINT_WORD_BYTES);
+
+    for (size_t i = 0; i < k; i++) {
+        // t += a[i] * b
+        bigIntDword_t carry = 0;
+        bigIntWord_t ai = a[i];
+        for (size_t j = 0; j < k; j++) {
+            bigIntDword_t sum = (bigIntDword_t)ai * b[j] + t[j] + carry;
+            t[j] = (bigIntWord_t)sum;
+            carry = sum >> BIGINT_WORD_BITS;
         }
-        
-        status = bigint_mod(&b, &temp, mod);
-        if (status != BIGINT_OK) {
-            return status;
+        bigIntDword_t top = (bigIntDword_t)t[k] + carry;
+        t[k] = (bigIntWord_t)top;
+        t[k + 1] = (bigIntWord_t)(top >> BIGINT_WORD_BITS);
+
+        // t = (t + m * n) / B, with m chosen so the low word cancels
+        bigIntWord_t m = t[0] * n0inv;
+        carry = ((bigIntDword_t)m * n[0] + t[0]) >> BIGINT_WORD_BITS;
+        for (size_t j = 1; j < k; j++) {
+            bigIntDword_t sum = (bigIntDword_t)m * n[j] + t[j] + carry;
+            t[j - 1] = (bigIntWord_t)sum;
+            carry = sum >> BIGINT_WORD_BITS;
         }
-        
-        // Divide exponent by 2
-        status = bigint_shift_right(&e, 1);
+        top = (bigIntDword_t)t[k] + carry;
+        t[k - 1] = (bigIntWord_t)top;
+        t[k] = t[k + 1] + (bigIntWord_t)(top >> BIGINT_WORD_BITS);
+    }
+
+    // t < 2n here, one conditional subtraction brings it below n
+    if (t[k] || bigint_words_cmp(t, n, k) >= 0) {
+        bigint_words_sub(r, t, n, k);
+    } else {
+        memcpy(r, t, k * BIGINT_WORD_BYTES);
+    }
+}
+
+/*
+ * r = t * R^-1 mod n for a 2k-word t < n * R (separate reduction pass after a
+ * full product). t is clobbered.
+ */
+static void bigint_mont_redc(bigIntWord_t *r, bigIntWord_t *t, const bigIntWord_t *n,
+                             bigIntWord_t n0inv, size_t k) {
+    bigIntWord_t c2 = 0;
+    for (size_t i = 0; i < k; i++) {
+        bigIntWord_t m = t[i] * n0inv;
+        bigIntWord_t carry = bigint_words_addmul_1(t + i, n, k, m);
+        bigIntDword_t sum = (bigIntDword_t)t[i + k] + carry + c2;
+        t[i + k] = (bigIntWord_t)sum;
+        c2 = (bigIntWord_t)(sum >> BIGINT_WORD_BITS);
+    }
+    if (c2 || bigint_words_cmp(t + k, n, k) >= 0) {
+        bigint_words_sub(r, t + k, n, k);
+    } else {
+        memcpy(r, t + k, k * BIGINT_WORD_BYTES);
+    }
+}
+
+// Montgomery product; large moduli take the Karatsuba product + REDC route.
+// t needs BIGINT_MONT_SCRATCH(k) words.
+static void bigint_mont_mul_words(bigIntWord_t *r, const bigIntWord_t *a, const bigIntWord_t *b,
+                                  const bigIntWord_t *n, bigIntWord_t n0inv, size_t k, bigIntWord_t *t) {
+    if (k < BIGINT_KARATSUBA_THRESHOLD) {
+        bigint_mont_mul_cios(r, a, b, n, n0inv, k, t);
+        return;
+    }
+    bigint_words_mul_n(t, a, b, k, t + 2 * k);
+    bigint_mont_redc(r, t, n, n0inv, k);
+}
+
+// Montgomery square: dedicated squaring (half the cross products) + REDC.
+// t needs BIGINT_MONT_SCRATCH(k) words.
+static void bigint_mont_sqr_words(bigIntWord_t *r, const bigIntWord_t *a,
+                                  const bigIntWord_t *n, bigIntWord_t n0inv, size_t k, bigIntWord_t *t) {
+    bigint_words_sqr_n(t, a, k, t + 2 * k);
+    bigint_mont_redc(r, t, n, n0inv, k);
+}
+
+// t = 2t mod n over k words (t < n)
+static void bigint_words_dbl_mod(bigIntWord_t *t, const bigIntWord_t *n, size_t k) {
+    bigIntWord_t carry = 0;
+    for (size_t i = 0; i < k; i++) {
+        bigIntWord_t next = t[i] >> (BIGINT_WORD_BITS - 1);
+        t[i] = (t[i] << 1) | carry;
+        carry = next;
+    }
+    if (carry || bigint_words_cmp(t, n, k) >= 0) {
+        bigint_words_sub(t, t, n, k);
+    }
+}
+
+#if BIGINT_SIMD
+// t = t / 2 mod n over k words (t < n, n odd)
+static void bigint_words_half_mod(bigIntWord_t *t, const bigIntWord_t *n, size_t k) {
+    bigIntWord_t top = 0;
+    if (t[0] & 1) {
+        top = bigint_words_add(t, t, n, k);
+    }
+    for (size_t i = 0; i < k; i++) {
+        bigIntWord_t next = (i + 1 < k) ? t[i + 1] : top;
+        t[i] = (t[i] >> 1) | (next << (BIGINT_WORD_BITS - 1));
+    }
+}
+#endif
+
+/**
+ * Precomputes the Montgomery constants for an odd modulus.
+ * 
+ * @param ctx Pointer to the context to fill.
+ * @param mod Pointer to the modulus (must be odd).
+ * @return Status code indicating success, invalid (even) modulus or null error.
+ */
+bigIntStatus_t bigint_mont_init(bigIntMontCtx_t *ctx, const bigInt_t *mod) {
+    if (!ctx || !mod) return BIGINT_ERR_NULL;
+    if (bigint_is_zero(mod)) return BIGINT_ERR_DIV_ZERO;
+    if (!(mod->words[0] & 1)) return BIGINT_ERR_INVALID;
+
+    if (mod->length > BIGINT_MAX_MOD_WORDS) return BIGINT_ERR_OVERFLOW;
+
+    size_t k = mod->length;
+    const bigIntWord_t *n = mod->words;
+    memcpy(ctx->n, n, k * BIGINT_WORD_BYTES);
+    ctx->length = (uint32_t)k;
+
+    // Newton iteration for n[0]^-1 mod B: n[0] is its own inverse mod 8 and
+    // each step doubles the number of correct low bits
+    bigIntWord_t inv = n[0];
+    for (int bits = 3; bits < BIGINT_WORD_BITS; bits *= 2) {
+        inv *= 2 - n[0] * inv;
+    }
+    ctx->n0inv = (bigIntWord_t)0 - inv;
+
+    // Start from 2^bits - n, which is already below n
+    bigIntWord_t top = n[k - 1];
+    size_t top_bits = 0;
+    while (top) { top >>= 1; top_bits++; }
+    size_t bits = (k - 1) * BIGINT_WORD_BITS + top_bits;
+
+    bigIntWord_t t[BIGINT_MAX_MOD_WORDS];
+    bigIntWord_t zero[BIGINT_MAX_MOD_WORDS] = {0};
+    bigIntWord_t scratch[BIGINT_MONT_SCRATCH(BIGINT_MAX_MOD_WORDS)];
+    bigint_words_sub(t, zero, n, k);
+    if (top_bits < BIGINT_WORD_BITS) {
+        t[k - 1] &= ((bigIntWord_t)1 << top_bits) - 1;
+    }
+    if (bigint_words_cmp(t, n, k) >= 0) {
+        bigint_words_sub(t, t, n, k); // only for n == 1
+    }
+
+    // Split log2(R) = odd * 2^squarings: double up to R * 2^odd, then each
+    // Montgomery squaring of R * 2^x gives R * 2^(2x), ending at R^2 mod n
+    size_t odd = k * BIGINT_WORD_BITS;
+    size_t squarings = 0;
+    while (!(odd & 1)) { odd >>= 1; squarings++; }
+
+    for (size_t i = bits; i < k * BIGINT_WORD_BITS + odd; i++) {
+        bigint_words_dbl_mod(t, n, k);
+    }
+    for (size_t i = 0; i < squarings; i++) {
+        bigint_mont_sqr_words(t, t, n, ctx->n0inv, k, scratch);
+    }
+
+    memcpy(ctx->rr, t, k * BIGINT_WORD_BYTES);
+
+    // Vector kernels where the host has them; a failure leaves the portable one
+    ctx->kernel = BIGINT_KERNEL_PORTABLE;
+    if (bits >= BIGINT_SIMD_MIN_BITS) {
+        bigint_mont_set_kernel(ctx, bigint_kernel_detect());
+    }
+    return BIGINT_OK;
+}
+
+/**
+ * Returns the fastest Montgomery kernel this CPU supports.
+ * 
+ * @return BIGINT_KERNEL_IFMA, BIGINT_KERNEL_AVX2 or BIGINT_KERNEL_PORTABLE.
+ */
+bigIntKernel_t bigint_kernel_detect(void) {
+#if BIGINT_SIMD
+    if (bigint_simd_supported(BIGINT_KERNEL_IFMA)) return BIGINT_KERNEL_IFMA;
+    // 29-bit AVX2 lanes only beat the portable kernel on 32-bit limbs
+    if (BIGINT_WORD_BITS == 32 && bigint_simd_supported(BIGINT_KERNEL_AVX2)) return BIGINT_KERNEL_AVX2;
+#endif
+    return BIGINT_KERNEL_PORTABLE;
+}
+
+/**
+ * Selects the kernel used by exponentiations with this context (bigint_mont_init
+ * already picks bigint_kernel_detect() for moduli of BIGINT_SIMD_MIN_BITS and up).
+ * 
+ * @param ctx Pointer to an initialized Montgomery context.
+ * @param kernel Kernel to use.
+ * @return Status code indicating success, or invalid if the kernel is not built
+ *         in or not supported by this CPU (the context is then unchanged).
+ */
+bigIntStatus_t bigint_mont_set_kernel(bigIntMontCtx_t *ctx, bigIntKernel_t kernel) {
+    if (!ctx) return BIGINT_ERR_NULL;
+    if (kernel == BIGINT_KERNEL_PORTABLE) {
+        ctx->kernel = kernel;
+        return BIGINT_OK;
+    }
+#if BIGINT_SIMD
+    if (!bigint_simd_supported(kernel)) return BIGINT_ERR_INVALID;
+
+    unsigned radix = bigint_simd_radix(kernel);
+    bigInt_t n = bigint_mont_modulus(ctx);
+    size_t limbs = ((bigint_bit_length(&n) + 2 + radix - 1) / radix + 3) & ~(size_t)3;
+    if (limbs > BIGINT_SIMD_MAX_LIMBS) return BIGINT_ERR_INVALID;
+
+    // R'^2 mod n from R^2 mod n: R' and R differ by a few words at most, so a
+    // handful of modular doublings (or halvings) beat a fresh exponentiation
+    size_t k = ctx->length;
+    size_t from = 2 * k * BIGINT_WORD_BITS;
+    size_t to = 2 * radix * limbs;
+    bigIntWord_t rr[BIGINT_MAX_MOD_WORDS];
+    memcpy(rr, ctx->rr, k * BIGINT_WORD_BYTES);
+    for (size_t i = from; i < to; i++) bigint_words_dbl_mod(rr, ctx->n, k);
+    for (size_t i = to; i < from; i++) bigint_words_half_mod(rr, ctx->n, k);
+
+    bigint_simd_setup(ctx, kernel, limbs, rr, k);
+    return BIGINT_OK;
+#else
+    return BIGINT_ERR_INVALID;
+#endif
+}
+
+// x = a mod n over k = ctx->length words
+static bigIntStatus_t bigint_mont_load_reduced(bigIntWord_t *x, const bigInt_t *a, const bigIntMontCtx_t *ctx) {
+    size_t k = ctx->length;
+    if (bigint_mont_reduced(a, ctx)) {
+        bigint_mont_load(x, a, k);
+    } else {
+        bigIntWord_t reduced_words[BIGINT_MAX_MOD_WORDS];
+        bigInt_t reduced;
+        bigInt_t n = bigint_mont_modulus(ctx);
+        bigint_init(&reduced, reduced_words, BIGINT_MAX_MOD_WORDS);
+        bigIntStatus_t status = bigint_mod(&reduced, a, &n);
         if (status != BIGINT_OK) return status;
-        
-        iteration++;
+        bigint_mont_load(x, &reduced, k);
     }
-    
-    if (iteration >= MAX_ITERATIONS) {
-        return BIGINT_ERR_OVERFLOW;
+    return BIGINT_OK;
+}
+
+// x = a * R mod n over k = ctx->length words, reducing a first if needed
+// (t: BIGINT_MONT_SCRATCH(k) words)
+static bigIntStatus_t bigint_mont_enter(bigIntWord_t *x, const bigInt_t *a, const bigIntMontCtx_t *ctx,
+                                        bigIntWord_t *t) {
+    bigIntStatus_t status = bigint_mont_load_reduced(x, a, ctx);
+    if (status != BIGINT_OK) return status;
+    bigint_mont_mul_words(x, x, ctx->rr, ctx->n, ctx->n0inv, ctx->length, t);
+    return BIGINT_OK;
+}
+
+/**
+ * Converts a big integer into the Montgomery domain: res = a * R mod n.
+ * 
+ * @param res Pointer to output big integer.
+ * @param a Pointer to the input (reduced modulo n first if needed).
+ * @param ctx Pointer to an initialized Montgomery context.
+ * @return Status code indicating success or error.
+ */
+bigIntStatus_t bigint_to_mont(bigInt_t *res, const bigInt_t *a, const bigIntMontCtx_t *ctx) {
+    if (!res || !a || !ctx) return BIGINT_ERR_NULL;
+
+    bigIntWord_t x[BIGINT_MAX_MOD_WORDS];
+    bigIntWord_t t[BIGINT_MONT_SCRATCH(BIGINT_MAX_MOD_WORDS)];
+    bigIntStatus_t status = bigint_mont_enter(x, a, ctx, t);
+    if (status != BIGINT_OK) return status;
+    return bigint_mont_store(res, x, ctx->length);
+}
+
+/**
+ * Converts a big integer out of the Montgomery domain: res = a * R^-1 mod n.
+ * 
+ * @param res Pointer to output big integer.
+ * @param a Pointer to the Montgomery-domain input (must be < n).
+ * @param ctx Pointer to an initialized Montgomery context.
+ * @return Status code indicating success or error.
+ */
+bigIntStatus_t bigint_from_mont(bigInt_t *res, const bigInt_t *a, const bigIntMontCtx_t *ctx) {
+    if (!res || !a || !ctx) return BIGINT_ERR_NULL;
+    if (!bigint_mont_reduced(a, ctx)) return BIGINT_ERR_INVALID;
+
+    size_t k = ctx->length;
+    bigIntWord_t x[BIGINT_MAX_MOD_WORDS], one[BIGINT_MAX_MOD_WORDS] = {1};
+    bigIntWord_t t[BIGINT_MONT_SCRATCH(BIGINT_MAX_MOD_WORDS)];
+    bigint_mont_load(x, a, k);
+
+    bigint_mont_mul_words(x, x, one, ctx->n, ctx->n0inv, k, t);
+    return bigint_mont_store(res, x, k);
+}
+
+/**
+ * Montgomery product: res = a * b * R^-1 mod n.
+ * 
+ * @param res Pointer to output big integer (may alias a or b).
+ * @param a Pointer to the first Montgomery-domain operand (must be < n).
+ * @param b Pointer to the second Montgomery-domain operand (must be < n).
+ * @param ctx Pointer to an initialized Montgomery context.
+ * @return Status code indicating success or error.
+ */
+bigIntStatus_t bigint_mont_mul(bigInt_t *res, const bigInt_t *a, const bigInt_t *b, const bigIntMontCtx_t *ctx) {
+    if (!res || !a || !b || !ctx) return BIGINT_ERR_NULL;
+    if (!bigint_mont_reduced(a, ctx) || !bigint_mont_reduced(b, ctx)) {
+        return BIGINT_ERR_INVALID;
     }
-    
-    return bigint_copy(res, &result);
+
+    size_t k = ctx->length;
+    bigIntWord_t x[BIGINT_MAX_MOD_WORDS], y[BIGINT_MAX_MOD_WORDS];
+    bigIntWord_t t[BIGINT_MONT_SCRATCH(BIGINT_MAX_MOD_WORDS)];
+    bigint_mont_load(x, a, k);
+    bigint_mont_load(y, b, k);
+
+    bigint_mont_mul_words(x, x, y, ctx->n, ctx->n0inv, k, t);
+    return bigint_mont_store(res, x, k);
+}
+
+/**
+ * Montgomery square: res = a * a * R^-1 mod n.
+ * 
+ * @param res Pointer to output big integer (may alias a).
+ * @param a Pointer to the Montgomery-domain operand (must be < n).
+ * @param ctx Pointer to an initialized Montgomery context.
+ * @return Status code indicating success or error.
+ */
+bigIntStatus_t bigint_mont_sqr(bigInt_t *res, const bigInt_t *a, const bigIntMontCtx_t *ctx) {
+    if (!res || !a || !ctx) return BIGINT_ERR_NULL;
+    if (!bigint_mont_reduced(a, ctx)) return BIGINT_ERR_INVALID;
+
+    size_t k = ctx->length;
+    bigIntWord_t x[BIGINT_MAX_MOD_WORDS];
+    bigIntWord_t t[BIGINT_MONT_SCRATCH(BIGINT_MAX_MOD_WORDS)];
+    bigint_mont_load(x, a, k);
+
+    bigint_mont_sqr_words(x, x, ctx->n, ctx->n0inv, k, t);
+    return bigint_mont_store(res, x, k);
+}
+
+// Sliding-window width for an exponent of the given size (fewest multiplies
+// once the 2^(w-1) table entries are counted in)
+static unsigned bigint_exp_window(size_t bits) {
+    unsigned w = (bits > 671) ? 6 : (bits > 239) ? 5 : (bits > 79) ? 4 : (bits > 23) ? 3 : 1;
+    return (w > BIGINT_EXP_WINDOW_MAX) ? BIGINT_EXP_WINDOW_MAX : w;
+}
+
+/*
+ * x = b^e for a single nonzero exponent word, left-to-right over the bits of
+ * e. Public exponents (3, 65537) need bit_length(e) - 1 squarings plus one
+ * multiply per extra set bit, with no exponent copy.
+ */
+static void bigint_mont_exp_word(bigIntWord_t *x, const bigIntWord_t *b, bigIntWord_t e,
+                                 const bigIntMontCtx_t *ctx, size_t k, bigIntWord_t *t) {
+    const bigIntWord_t *n = ctx->n;
+    int bit = BIGINT_WORD_BITS - 1 - (int)bigint_clz(e);
+
+    memcpy(x, b, k * BIGINT_WORD_BYTES);
+    while (bit-- > 0) {
+        bigint_mont_sqr_words(x, x, n, ctx->n0inv, k, t);
+        if ((e >> bit) & 1) {
+            bigint_mont_mul_words(x, x, b, n, ctx->n0inv, k, t);
+        }
+    }
+}
+
+/*
+ * x = b^e with a left-to-right sliding window over a nonzero exponent: the odd
+ * powers b, b^3, ..., b^(2^w - 1) are tabulated once, then each window of up
+ * to w bits that starts and ends with a 1 costs one multiply.
+ */
+static void bigint_mont_exp_window(bigIntWord_t *x, const bigIntWord_t *b, const bigInt_t *e,
+                                   const bigIntMontCtx_t *ctx, size_t k, bigIntWord_t *t) {
+    const bigIntWord_t *n = ctx->n;
+    bigIntWord_t table[1 << (BIGINT_EXP_WINDOW_MAX - 1)][BIGINT_MAX_MOD_WORDS];
+    size_t bits = bigint_bit_length(e);
+    unsigned w = bigint_exp_window(bits);
+
+    // table[i] = b^(2i + 1)
+    memcpy(table[0], b, k * BIGINT_WORD_BYTES);
+    if (w > 1) {
+        bigIntWord_t b2[BIGINT_MAX_MOD_WORDS];
+        bigint_mont_sqr_words(b2, b, n, ctx->n0inv, k, t);
+        for (size_t i = 1; i < ((size_t)1 << (w - 1)); i++) {
+            bigint_mont_mul_words(table[i], table[i - 1], b2, n, ctx->n0inv, k, t);
+        }
+    }
+
+    bool started = false;
+    size_t i = bits;
+    while (i-- > 0) {
+        if (!bigint_get_bit(e, i)) {
+            bigint_mont_sqr_words(x, x, n, ctx->n0inv, k, t);
+            continue;
+        }
+
+        // Longest window [i .. low] of at most w bits ending in a set bit
+        size_t low = (i + 1 >= w) ? i + 1 - w : 0;
+        while (!bigint_get_bit(e, low)) low++;
+
+        size_t value = 0;
+        for (size_t j = i + 1; j-- > low;) {
+            value = (value << 1) | bigint_get_bit(e, j);
+        }
+
+        if (started) {
+            for (size_t j = low; j <= i; j++) {
+                bigint_mont_sqr_words(x, x, n, ctx->n0inv, k, t);
+            }
+            bigint_mont_mul_words(x, x, table[value >> 1], n, ctx->n0inv, k, t);
+        } else {
+            memcpy(x, table[value >> 1], k * BIGINT_WORD_BYTES);
+            started = true;
+        }
+        i = low;
+    }
+}
+
+/**
+ * Computes modular exponentiation in the Montgomery domain: res = (base^exp) mod n.
+ * 
+ * Single-word exponents use a plain left-to-right bit scan; larger ones
+ * (private-key operations) use a sliding window.
+ * 
+ * @param res Pointer to output big integer (ordinary, not Montgomery form).
+ * @param base Pointer to base (any size, reduced modulo n first).
+ * @param exp Pointer to exponent.
+ * @param ctx Pointer to an initialized Montgomery context.
+ * @return Status code indicating success or error.
+ */
+bigIntStatus_t bigint_mont_exp(bigInt_t *res, const bigInt_t *base, const bigInt_t *exp, const bigIntMontCtx_t *ctx) {
+    if (!res || !base || !exp || !ctx) return BIGINT_ERR_NULL;
+    if (exp->length <= 1) {
+        return bigint_mont_exp_uint(res, base, exp->words[0], ctx);
+    }
+
+    size_t k = ctx->length;
+    bigIntWord_t b[BIGINT_MAX_MOD_WORDS], x[BIGINT_MAX_MOD_WORDS], one[BIGINT_MAX_MOD_WORDS] = {1};
+    bigIntWord_t t[BIGINT_MONT_SCRATCH(BIGINT_MAX_MOD_WORDS)];
+
+    bigIntStatus_t status = bigint_mont_enter(b, base, ctx, t);
+    if (status != BIGINT_OK) return status;
+
+    bigint_mont_exp_window(x, b, exp, ctx, k, t);
+
+    bigint_mont_mul_words(x, x, one, ctx->n, ctx->n0inv, k, t);
+    return bigint_mont_store(res, x, k);
+}
+
+/**
+ * Modular exponentiation by a single-word exponent such as the RSA public
+ * exponent: res = (base^exp) mod n, without building an exponent big integer.
+ * 
+ * @param res Pointer to output big integer (ordinary, not Montgomery form).
+ * @param base Pointer to base (any size, reduced modulo n first).
+ * @param exp Exponent value.
+ * @param ctx Pointer to an initialized Montgomery context.
+ * @return Status code indicating success or error.
+ */
+bigIntStatus_t bigint_mont_exp_uint(bigInt_t *res, const bigInt_t *base, bigIntWord_t exp, const bigIntMontCtx_t *ctx) {
+    if (!res || !base || !ctx) return BIGINT_ERR_NULL;
+
+    _Alignas(BIGINT_SCRATCH_ALIGN) bigIntWord_t scratch[BIGINT_MONT_EXP_UINT_SCRATCH(BIGINT_MAX_MOD_WORDS)];
+    bigIntWord_t reduced_words[BIGINT_MAX_MOD_WORDS];
+    bigInt_t reduced;
+    if (!bigint_mont_reduced(base, ctx)) {
+        bigInt_t n = bigint_mont_modulus(ctx);
+        bigint_init(&reduced, reduced_words, BIGINT_MAX_MOD_WORDS);
+        bigIntStatus_t status = bigint_mod(&reduced, base, &n);
+        if (status != BIGINT_OK) return status;
+        base = &reduced;
+    }
+    return bigint_mont_exp_uint_ws(res, base, exp, ctx, scratch);
+}
+
+/**
+ * bigint_mont_exp_uint with every temporary in caller-supplied scratch, so
+ * the stack use stays small and fixed.
+ * 
+ * @param res Pointer to output big integer (ordinary, not Montgomery form).
+ * @param base Pointer to base (must be < n).
+ * @param exp Exponent value.
+ * @param ctx Pointer to an initialized Montgomery context.
+ * @param scratch BIGINT_MONT_EXP_UINT_SCRATCH(ctx->length) words, BIGINT_SCRATCH_ALIGN-byte aligned.
+ * @return Status code indicating success or error.
+ */
+bigIntStatus_t bigint_mont_exp_uint_ws(bigInt_t *res, const bigInt_t *base, bigIntWord_t exp,
+                                       const bigIntMontCtx_t *ctx, bigIntWord_t *scratch) {
+    if (!res || !base || !ctx || !scratch) return BIGINT_ERR_NULL;
+    if (((uintptr_t)scratch & (BIGINT_SCRATCH_ALIGN - 1)) || !bigint_mont_reduced(base, ctx)) {
+        return BIGINT_ERR_INVALID;
+    }
+
+    size_t k = ctx->length;
+    bigIntWord_t *b = scratch, *x = scratch + k, *one = scratch + 2 * k;
+    bigIntWord_t *t = scratch + BIGINT_SCRATCH_ROUND(3 * k);
+    memset(one, 0, k * BIGINT_WORD_BYTES);
+    one[0] = 1;
+
+    if (exp == 0) {
+        // base^0 = 1 (mod n), i.e. R * R^-1; also right for n == 1
+        bigint_mont_mul_words(x, ctx->rr, one, ctx->n, ctx->n0inv, k, t);
+    } else {
+        bigint_mont_load(b, base, k);
+#if BIGINT_SIMD
+        if (ctx->kernel != BIGINT_KERNEL_PORTABLE) {
+            // The vector kernels keep their own domain and return x <= n
+            bigint_simd_mont_exp_word(x, b, exp, ctx, (uint64_t *)t);
+            if (bigint_words_cmp(x, ctx->n, k) >= 0) {
+                bigint_words_sub(x, x, ctx->n, k);
+            }
+            return bigint_mont_store(res, x, k);
+        }
+#endif
+        bigint_mont_mul_words(b, b, ctx->rr, ctx->n, ctx->n0inv, k, t);
+        bigint_mont_exp_word(x, b, exp, ctx, k, t);
+    }
+
+    bigint_mont_mul_words(x, x, one, ctx->n, ctx->n0inv, k, t);
+    return bigint_mont_store(res, x, k);
+}
+
+/**
+ * Runs many single-word exponentiations under one modulus, such as checking a
+ * batch of signatures made with the same key: res[i] = (base[i]^exp) mod n.
+ * 
+ * With a vector kernel, groups of 8 (IFMA) or 4 (AVX2) bases go through one
+ * exponentiation side by side, one base per SIMD lane. A context on the
+ * portable kernel still batches on AVX2 hosts (the lane constants are set up
+ * once per call); elsewhere this is a loop over bigint_mont_exp_uint.
+ * 
+ * @param res Array of count output big integers (ordinary form).
+ * @param base Array of count bases (any size, reduced modulo n first).
+ * @param count Number of exponentiations.
+ * @param exp Exponent shared by all of them.
+ * @param ctx Pointer to an initialized Montgomery context.
+ * @return Status code of the first failure (later items are still computed), or success.
+ *         A NULL res[i] or base[i] is BIGINT_ERR_NULL on every path.
+ */
+bigIntStatus_t bigint_mont_exp_uint_batch(bigInt_t *const res[], const bigInt_t *const base[], size_t count,
+                                          bigIntWord_t exp, const bigIntMontCtx_t *ctx) {
+    if (!res || !base || !ctx) return BIGINT_ERR_NULL;
+
+    bigIntStatus_t result = BIGINT_OK;
+    size_t done = 0;
+#if BIGINT_SIMD
+    bigIntMontCtx_t avx2_ctx;
+    const bigIntMontCtx_t *lanes_ctx = ctx;
+    if (ctx->kernel == BIGINT_KERNEL_PORTABLE && count >= 2 * bigint_simd_batch_lanes(BIGINT_KERNEL_AVX2) &&
+        ctx->length * BIGINT_WORD_BITS >= BIGINT_SIMD_MIN_BITS) {
+        avx2_ctx = *ctx;
+        if (bigint_mont_set_kernel(&avx2_ctx, BIGINT_KERNEL_AVX2) == BIGINT_OK) lanes_ctx = &avx2_ctx;
+    }
+
+    size_t lanes = bigint_simd_batch_lanes(lanes_ctx->kernel);
+    size_t k = ctx->length;
+    while (exp != 0 && lanes > 1 && count - done >= 2) {
+        size_t group = (count - done < lanes) ? count - done : lanes;
+        bigIntWord_t b[BIGINT_BATCH_MAX_LANES][BIGINT_MAX_MOD_WORDS];
+        bigIntWord_t x[BIGINT_BATCH_MAX_LANES][BIGINT_MAX_MOD_WORDS];
+        const bigIntWord_t *bp[BIGINT_BATCH_MAX_LANES];
+        bigIntWord_t *xp[BIGINT_BATCH_MAX_LANES];
+
+        for (size_t l = 0; l < group; l++) {
+            // A NULL entry fails as in bigint_mont_exp_uint and its lane runs on 0
+            bigIntStatus_t status = BIGINT_ERR_NULL;
+            if (base[done + l] && res[done + l]) status = bigint_mont_load_reduced(b[l], base[done + l], ctx);
+            if (status != BIGINT_OK) {
+                if (result == BIGINT_OK) result = status;
+                memset(b[l], 0, k * BIGINT_WORD_BYTES);
+            }
+            bp[l] = b[l];
+            xp[l] = x[l];
+        }
+        bigint_simd_mont_exp_word_batch(xp, bp, group, exp, lanes_ctx);
+
+        for (size_t l = 0; l < group; l++) {
+            if (!base[done + l] || !res[done + l]) continue;
+            if (bigint_words_cmp(x[l], ctx->n, k) >= 0) {
+                bigint_words_sub(x[l], x[l], ctx->n, k);
+            }
+            bigIntStatus_t status = bigint_mont_store(res[done + l], x[l], k);
+            if (status != BIGINT_OK && result == BIGINT_OK) result = status;
+        }
+        done += group;
+    }
+#endif
+    for (; done < count; done++) {
+        bigIntStatus_t status = bigint_mont_exp_uint(res[done], base[done], exp, ctx);
+        if (status != BIGINT_OK && result == BIGINT_OK) result = status;
+    }
+    return result;
 }
@@ -5,9 +5,100 @@
 #include <stddef.h>
 #include <stdbool.h>
 
-#define BIGINT_WORD_BITS     (32)
+// Limb width, selectable at build time with -DBIGINT_WORD_BITS=32 or 64.
+// 64-bit limbs need a 128-bit product type (GCC/Clang on 64-bit targets),
+// everything else (embedded targets) defaults to 32-bit limbs.
+#ifndef BIGINT_WORD_BITS
+#if defined(__SIZEOF_INT128__)
+#define BIGINT_WORD_BITS     64
+#else
+#define BIGINT_WORD_BITS     32
+#endif
+#endif
+
+#if BIGINT_WORD_BITS == 64
+typedef uint64_t bigIntWord_t;
+__extension__ typedef unsigned __int128 bigIntDword_t;
+#define BIGINT_WORD_BYTES    (8)
+#elif BIGINT_WORD_BITS == 32
+typedef uint32_t bigIntWord_t;
+typedef uint64_t bigIntDword_t;
 #define BIGINT_WORD_BYTES    (4)
-#define BIGINT_MAX_WORDS     (128) // 64 * 32 = 2048 bits
+#else
+#error "BIGINT_WORD_BITS must be 32 or 64"
+#endif
+
+// Largest modulus the library handles (2048, 3072 and 4096-bit RSA by default).
+// Only internal scratch buffers are sized from it; a bigInt_t carries its own
+// capacity, so smaller numbers never touch memory they do not need.
+// Bootloaders that only verify RSA-2048 can build with -DBIGINT_MAX_MOD_BITS=2048.
+#ifndef BIGINT_MAX_MOD_BITS
+#define BIGINT_MAX_MOD_BITS  (4096)
+#endif
+
+#define BIGINT_WORDS_FOR_BITS(bits) (((bits) + BIGINT_WORD_BITS - 1) / BIGINT_WORD_BITS)
+#define BIGINT_MAX_MOD_WORDS BIGINT_WORDS_FOR_BITS(BIGINT_MAX_MOD_BITS)
+#define BIGINT_MAX_WORDS     (2 * BIGINT_MAX_MOD_WORDS) // largest operand: a product of two residues
+
+// Operands of at least this many words are multiplied/squared with Karatsuba
+#ifndef BIGINT_KARATSUBA_THRESHOLD
+#define BIGINT_KARATSUBA_THRESHOLD  (48)
+#endif
+// Scratch words needed by a Karatsuba product of two n-word operands
+#define BIGINT_KARATSUBA_SCRATCH(n) (6 * (n) + 64)
+
+// Largest sliding window for big exponents (table of 2^(w-1) odd powers)
+#ifndef BIGINT_EXP_WINDOW_MAX
+#define BIGINT_EXP_WINDOW_MAX       (5)
+#endif
+
+// Vectorized Montgomery kernels (bigint_simd.c): AVX-512 IFMA in radix 2^52 and
+// AVX2 in radix 2^29, picked at run time from the CPU features. Only built for
+// x86-64 GCC/Clang; -DBIGINT_SIMD=0 leaves just the portable code.
+#ifndef BIGINT_SIMD
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BIGINT_SIMD          1
+#else
+#define BIGINT_SIMD          0
+#endif
+#endif
+// Limbs for the largest modulus in the narrowest (29-bit) radix, plus the two
+// bits of headroom the kernels need, rounded up to whole 4-lane vectors
+#define BIGINT_SIMD_MAX_LIMBS ((((BIGINT_MAX_MOD_BITS) + 2 + 28) / 29 + 3) & ~3)
+// Most exponentiations bigint_mont_exp_uint_batch runs side by side (IFMA: 8 lanes)
+#define BIGINT_BATCH_MAX_LANES (8)
+// Smaller moduli stay on the portable kernel, where the vector setup costs more than it saves
+#ifndef BIGINT_SIMD_MIN_BITS
+#define BIGINT_SIMD_MIN_BITS (1024)
+#endif
+
+// Caller-supplied scratch for the *_ws functions, in words for a modulus of k
+// words, BIGINT_SCRATCH_ALIGN-byte aligned (the vector kernels view it as
+// 64-bit limbs). Sizing for BIGINT_MAX_MOD_WORDS covers every modulus.
+#define BIGINT_SCRATCH_ALIGN (64)
+#define BIGINT_SCRATCH_ROUND(words) \
+    (((words) + BIGINT_SCRATCH_ALIGN / BIGINT_WORD_BYTES - 1) & ~(size_t)(BIGINT_SCRATCH_ALIGN / BIGINT_WORD_BYTES - 1))
+// One Montgomery product or square: the double-width product (two more words
+// for CIOS), plus Karatsuba scratch above the threshold
+#define BIGINT_MONT_SCRATCH(k) \
+    (2 * (k) + 2 + ((k) >= BIGINT_KARATSUBA_THRESHOLD ? BIGINT_KARATSUBA_SCRATCH(k) : 0))
+#if BIGINT_SIMD
+// Vector exponentiation: base, accumulator and 1 in 29-bit limbs (the most limbs of any kernel)
+#define BIGINT_SIMD_SCRATCH(k) \
+    (3 * (((((k) * BIGINT_WORD_BITS) + 2 + 28) / 29 + 3) & ~3) * (8 / BIGINT_WORD_BYTES))
+#else
+#define BIGINT_SIMD_SCRATCH(k) (0)
+#endif
+// bigint_mont_exp_uint_ws: base, result and 1, then one product or the vector state
+#define BIGINT_MONT_EXP_UINT_SCRATCH(k) (BIGINT_SCRATCH_ROUND(3 * (k)) + \
+    (BIGINT_MONT_SCRATCH(k) > BIGINT_SIMD_SCRATCH(k) ? BIGINT_MONT_SCRATCH(k) : BIGINT_SIMD_SCRATCH(k)))
+
+// Montgomery multiplication kernel used by a bigIntMontCtx_t
+typedef enum {
+    BIGINT_KERNEL_PORTABLE = 0,  // word-sized CIOS / Karatsuba + REDC (bigint.c)
+    BIGINT_KERNEL_AVX2 = 1,      // radix 2^29, _mm256_mul_epu32
+    BIGINT_KERNEL_IFMA = 2,      // radix 2^52, AVX-512 IFMA on 256-bit vectors
+} bigIntKernel_t;
 
 typedef enum {
     BIGINT_OK = 0,
@@ -17,11 +108,48 @@ typedef enum {
     BIGINT_ERR_INVALID = -4,
 } bigIntStatus_t;
 
+// Little-endian words in caller-owned storage of `capacity` words. Only
+// words[0..length) are meaningful: operations read and write exactly that
+// range, words above length hold stale data. Results are normalized (no zero
+// top word unless the value is 0, which has length 1).
 typedef struct {
-    uint32_t words[BIGINT_MAX_WORDS];
+    bigIntWord_t *words;
     uint32_t length; 
+    uint32_t capacity;
 } bigInt_t;
 
+// Declares a big integer `name` (value 0) backed by an array of `nwords` words
+// in the same scope, e.g. BIGINT_DEFINE(sig, BIGINT_WORDS_FOR_BITS(3072));
+#define BIGINT_DEFINE(name, nwords) \
+    bigIntWord_t name##_words[(nwords)] = {0}; \
+    bigInt_t name = { name##_words, 1, (nwords) }
+
+// Montgomery context for an odd modulus n with R = 2^(BIGINT_WORD_BITS * length)
+typedef struct {
+    bigIntWord_t n[BIGINT_MAX_MOD_WORDS];    // modulus
+    bigIntWord_t rr[BIGINT_MAX_MOD_WORDS];   // R^2 mod n, used to enter the Montgomery domain
+    bigIntWord_t n0inv;                      // -n^-1 mod 2^BIGINT_WORD_BITS
+    uint32_t length;                         // modulus length in words
+    bigIntKernel_t kernel;                   // kernel used by the exponentiation
+#if BIGINT_SIMD
+    // Vector kernel state: n and R'^2 mod n in simd_limbs limbs of the kernel
+    // radix, with R' = 2^(radix * simd_limbs) (set by bigint_mont_set_kernel)
+    uint32_t simd_limbs;
+    uint64_t simd_k0;                        // -n^-1 mod 2^radix
+    uint64_t simd_n[BIGINT_SIMD_MAX_LIMBS];
+    uint64_t simd_rr[BIGINT_SIMD_MAX_LIMBS];
+#endif
+} bigIntMontCtx_t;
+
+// Barrett context for repeated reductions by a fixed modulus m (any m > 0)
+typedef struct {
+    bigIntWord_t m[BIGINT_MAX_MOD_WORDS];        // modulus
+    bigIntWord_t mu[BIGINT_MAX_MOD_WORDS + 1];   // floor((B^(2 * length) - 1) / m), B = 2^BIGINT_WORD_BITS
+    uint32_t length;                             // modulus length in words
+    uint32_t mu_length;                          // mu length in words
+} bigIntBarrettCtx_t;
+
+bigIntStatus_t bigint_init(bigInt_t *a, bigIntWord_t *storage, size_t capacity);
 bigIntStatus_t bigint_zero(bigInt_t *a);
 bigIntStatus_t bigint_from_uint32(bigInt_t *a, uint32_t val);
 bigIntStatus_t bigint_from_bytes(bigInt_t *a, const uint8_t *bytes, size_t byte_len);
@@ -35,6 +163,7 @@ int  bigint_compare(const bigInt_t *a, const bigInt_t *b);
 bigIntStatus_t bigint_add(bigInt_t *res, const bigInt_t *a, const bigInt_t *b);
 bigIntStatus_t bigint_sub(bigInt_t *res, const bigInt_t *a, const bigInt_t *b); // required: a ≥ b
 bigIntStatus_t bigint_mul(bigInt_t *res, const bigInt_t *a, const bigInt_t *b);
+bigIntStatus_t bigint_sqr(bigInt_t *res, const bigInt_t *a);
 bigIntStatus_t bigint_divmod(bigInt_t *quot, bigInt_t *rem, const bigInt_t *num, const bigInt_t *den);
 bigIntStatus_t bigint_mod(bigInt_t *res, const bigInt_t *a, const bigInt_t *m);
 
@@ -43,4 +172,21 @@ bigIntStatus_t bigint_shift_right(bigInt_t *a, size_t bits);
 
 bigIntStatus_t bigint_mod_exp(bigInt_t *res, const bigInt_t *base, const bigInt_t *exp, const bigInt_t *mod);
 
+bigIntStatus_t bigint_barrett_init(bigIntBarrettCtx_t *ctx, const bigInt_t *mod);
+bigIntStatus_t bigint_mod_barrett(bigInt_t *res, const bigInt_t *a, const bigIntBarrettCtx_t *ctx);
+
+bigIntKernel_t bigint_kernel_detect(void);
+bigIntStatus_t bigint_mont_init(bigIntMontCtx_t *ctx, const bigInt_t *mod); // required: mod odd
+bigIntStatus_t bigint_mont_set_kernel(bigIntMontCtx_t *ctx, bigIntKernel_t kernel);
+bigIntStatus_t bigint_to_mont(bigInt_t *res, const bigInt_t *a, const bigIntMontCtx_t *ctx);
+bigIntStatus_t bigint_from_mont(bigInt_t *res, const bigInt_t *a, const bigIntMontCtx_t *ctx);
+bigIntStatus_t bigint_mont_mul(bigInt_t *res, const bigInt_t *a, const bigInt_t *b, const bigIntMontCtx_t *ctx);
+bigIntStatus_t bigint_mont_sqr(bigInt_t *res, const bigInt_t *a, const bigIntMontCtx_t *ctx);
+bigIntStatus_t bigint_mont_exp(bigInt_t *res, const bigInt_t *base, const bigInt_t *exp, const bigIntMontCtx_t *ctx);
+bigIntStatus_t bigint_mont_exp_uint(bigInt_t *res, const bigInt_t *base, bigIntWord_t exp, const bigIntMontCtx_t *ctx);
+bigIntStatus_t bigint_mont_exp_uint_ws(bigInt_t *res, const bigInt_t *base, bigIntWord_t exp,
+                                       const bigIntMontCtx_t *ctx, bigIntWord_t *scratch); // required: base < n
+bigIntStatus_t bigint_mont_exp_uint_batch(bigInt_t *const res[], const bigInt_t *const base[], size_t count,
+                                          bigIntWord_t exp, const bigIntMontCtx_t *ctx);
+
 #endif // BIG_INT_H
@@ -0,0 +1,479 @@
+#include "bigint_simd.h"
+#include <string.h>
+
+#if BIGINT_SIMD
+#include <immintrin.h>
+
+// ---------------------------------------------------------------------------
+// Vectorized Montgomery multiplication
+//
+// Numbers are held as L limbs of `radix` bits in 64-bit lanes (L a multiple
+// of 4), R' = 2^(radix * L) with R' > 4n. Both kernels compute the "almost
+// Montgomery" product a * b / R' mod n, which stays below 2n for inputs below
+// 2n, so the exponentiation needs no conditional subtraction per step.
+//
+// Each step adds a * b[i] and n * y to the accumulator vectors, with y chosen
+// to clear the lowest limb, then shifts the accumulator down one limb. Limbs
+// are left unnormalized inside the loop and carried only at the end.
+// ---------------------------------------------------------------------------
+
+#define BIGINT_IFMA_TARGET __attribute__((target("avx512f,avx512vl,avx512ifma")))
+#define BIGINT_AVX2_TARGET __attribute__((target("avx2")))
+
+#define BIGINT_SIMD_VECS (BIGINT_SIMD_MAX_LIMBS / 4)
+
+typedef void (*bigint_amm_fn)(uint64_t *r, const uint64_t *a, const uint64_t *b,
+                              const uint64_t *n, uint64_t k0, size_t limbs);
+
+// Carries unnormalized limbs down to `radix` bits each (value < R')
+static void bigint_simd_carry(uint64_t *r, size_t limbs, unsigned radix) {
+    uint64_t mask = ((uint64_t)1 << radix) - 1;
+    uint64_t carry = 0;
+    for (size_t j = 0; j < limbs; j++) {
+        uint64_t t = r[j] + carry;
+        r[j] = t & mask;
+        carry = t >> radix;
+    }
+}
+
+/*
+ * r = a * b / 2^(52L) mod n (< 2n) with AVX-512 IFMA on 256-bit vectors.
+ * madd52lo/madd52hi add the low/high 52 bits of a 52x52-bit product, so the
+ * high halves land one limb up and are added after the shift. Each lane takes
+ * four 52-bit terms per step, which leaves room for over 500 steps.
+ */
+BIGINT_IFMA_TARGET
+static void bigint_amm52(uint64_t *r, const uint64_t *a, const uint64_t *b,
+                         const uint64_t *n, uint64_t k0, size_t limbs) {
+    const uint64_t mask = ((uint64_t)1 << 52) - 1;
+    const __m256i zero = _mm256_setzero_si256();
+    size_t vecs = limbs / 4;
+    __m256i acc[BIGINT_SIMD_VECS];
+
+    for (size_t v = 0; v < vecs; v++) acc[v] = zero;
+
+    for (size_t i = 0; i < limbs; i++) {
+        __m256i bi = _mm256_set1_epi64x((long long)b[i]);
+        for (size_t v = 0; v < vecs; v++) {
+            __m256i av = _mm256_loadu_si256((const __m256i *)(a + 4 * v));
+            acc[v] = _mm256_madd52lo_epu64(acc[v], av, bi);
+        }
+
+        uint64_t acc0 = (uint64_t)_mm_cvtsi128_si64(_mm256_castsi256_si128(acc[0]));
+        uint64_t y = (acc0 * k0) & mask;
+        __m256i yi = _mm256_set1_epi64x((long long)y);
+        for (size_t v = 0; v < vecs; v++) {
+            __m256i nv = _mm256_loadu_si256((const __m256i *)(n + 4 * v));
+            acc[v] = _mm256_madd52lo_epu64(acc[v], nv, yi);
+        }
+
+        // The low limb is now 0 mod 2^52: drop it and carry its top bits
+        uint64_t carry = (acc0 + ((n[0] * y) & mask)) >> 52;
+        for (size_t v = 0; v + 1 < vecs; v++) {
+            acc[v] = _mm256_alignr_epi64(acc[v + 1], acc[v], 1);
+        }
+        acc[vecs - 1] = _mm256_alignr_epi64(zero, acc[vecs - 1], 1);
+        acc[0] = _mm256_add_epi64(acc[0], _mm256_zextsi128_si256(_mm_cvtsi64_si128((long long)carry)));
+
+        for (size_t v = 0; v < vecs; v++) {
+            __m256i av = _mm256_loadu_si256((const __m256i *)(a + 4 * v));
+            __m256i nv = _mm256_loadu_si256((const __m256i *)(n + 4 * v));
+            acc[v] = _mm256_madd52hi_epu64(acc[v], av, bi);
+            acc[v] = _mm256_madd52hi_epu64(acc[v], nv, yi);
+        }
+    }
+
+    for (size_t v = 0; v < vecs; v++) {
+        _mm256_storeu_si256((__m256i *)(r + 4 * v), acc[v]);
+    }
+    bigint_simd_carry(r, limbs, 52);
+}
+
+// Lane j of each result = carry of lane j - 1 (lane 0 from the previous vector)
+BIGINT_AVX2_TARGET
+static void bigint_amm29_normalize(__m256i *acc, size_t vecs) {
+    const __m256i mask = _mm256_set1_epi64x((1 << 29) - 1);
+    __m256i prev = _mm256_setzero_si256();
+    for (size_t v = 0; v < vecs; v++) {
+        __m256i carry = _mm256_permute4x64_epi64(_mm256_srli_epi64(acc[v], 29), _MM_SHUFFLE(2, 1, 0, 3));
+        __m256i in = _mm256_blend_epi32(carry, prev, 0x03);
+        acc[v] = _mm256_add_epi64(_mm256_and_si256(acc[v], mask), in);
+        prev = carry;
+    }
+}
+
+/*
+ * r = a * b / 2^(29L) mod n (< 2n) with AVX2. 29x29-bit products fit a lane
+ * whole (_mm256_mul_epu32), but two of them per step fill a lane in about 32
+ * steps, so the accumulator is partially carried every 8 steps.
+ */
+BIGINT_AVX2_TARGET
+static void bigint_amm29(uint64_t *r, const uint64_t *a, const uint64_t *b,
+                         const uint64_t *n, uint64_t k0, size_t limbs) {
+    const uint64_t mask = ((uint64_t)1 << 29) - 1;
+    const __m256i zero = _mm256_setzero_si256();
+    size_t vecs = limbs / 4;
+    __m256i acc[BIGINT_SIMD_VECS];
+
+    for (size_t v = 0; v < vecs; v++) acc[v] = zero;
+
+    for (size_t i = 0; i < limbs; i++) {
+        __m256i bi = _mm256_set1_epi64x((long long)b[i]);
+        for (size_t v = 0; v < vecs; v++) {
+            __m256i av = _mm256_loadu_si256((const __m256i *)(a + 4 * v));
+            acc[v] = _mm256_add_epi64(acc[v], _mm256_mul_epu32(av, bi));
+        }
+
+        uint64_t acc0 = (uint64_t)_mm_cvtsi128_si64(_mm256_castsi256_si128(acc[0]));
+        uint64_t y = (acc0 * k0) & mask;
+        __m256i yi = _mm256_set1_epi64x((long long)y);
+        for (size_t v = 0; v < vecs; v++) {
+            __m256i nv = _mm256_loadu_si256((const __m256i *)(n + 4 * v));
+            acc[v] = _mm256_add_epi64(acc[v], _mm256_mul_epu32(nv, yi));
+        }
+
+        // Shift down one limb: rotate each vector and pull in the next one's lane 0
+        uint64_t carry = (acc0 + n[0] * y) >> 29;
+        __m256i rot = _mm256_permute4x64_epi64(acc[0], _MM_SHUFFLE(0, 3, 2, 1));
+        for (size_t v = 0; v + 1 < vecs; v++) {
+            __m256i next = _mm256_permute4x64_epi64(acc[v + 1], _MM_SHUFFLE(0, 3, 2, 1));
+            acc[v] = _mm256_blend_epi32(rot, next, 0xC0);
+            rot = next;
+        }
+        acc[vecs - 1] = _mm256_blend_epi32(rot, zero, 0xC0);
+        acc[0] = _mm256_add_epi64(acc[0], _mm256_zextsi128_si256(_mm_cvtsi64_si128((long long)carry)));
+
+        if ((i & 7) == 7) {
+            bigint_amm29_normalize(acc, vecs);
+        }
+    }
+
+    for (size_t v = 0; v < vecs; v++) {
+        _mm256_storeu_si256((__m256i *)(r + 4 * v), acc[v]);
+    }
+    bigint_simd_carry(r, limbs, 29);
+}
+
+/**
+ * Checks whether the CPU (and OS) can run a vector kernel.
+ *
+ * @param kernel Kernel to check.
+ * @return true if the kernel can be used on this host.
+ */
+bool bigint_simd_supported(bigIntKernel_t kernel) {
+    __builtin_cpu_init();
+    switch (kernel) {
+    case BIGINT_KERNEL_IFMA:
+        return __builtin_cpu_supports("avx512ifma") && __builtin_cpu_supports("avx512vl");
+    case BIGINT_KERNEL_AVX2:
+        return __builtin_cpu_supports("avx2");
+    default:
+        return false;
+    }
+}
+
+unsigned bigint_simd_radix(bigIntKernel_t kernel) {
+    return (kernel == BIGINT_KERNEL_IFMA) ? 52 : 29;
+}
+
+// Splits k words into `limbs` limbs of `radix` bits, zero-padded
+static void bigint_simd_split(uint64_t *l, size_t limbs, unsigned radix,
+                              const bigIntWord_t *w, size_t k) {
+    uint64_t mask = ((uint64_t)1 << radix) - 1;
+    for (size_t j = 0; j < limbs; j++) {
+        size_t bit = j * radix;
+        size_t wi = bit / BIGINT_WORD_BITS;
+        unsigned off = bit % BIGINT_WORD_BITS;
+        uint64_t v = 0;
+        for (unsigned got = 0; got < radix && wi < k; wi++) {
+            v |= (uint64_t)(w[wi] >> off) << got;
+            got += BIGINT_WORD_BITS - off;
+            off = 0;
+        }
+        l[j] = v & mask;
+    }
+}
+
+// Packs normalized limbs back into k words (value must fit)
+static void bigint_simd_join(bigIntWord_t *w, size_t k, const uint64_t *l, size_t limbs,
+                             unsigned radix) {
+    memset(w, 0, k * BIGINT_WORD_BYTES);
+    for (size_t j = 0; j < limbs; j++) {
+        size_t bit = j * radix;
+        size_t wi = bit / BIGINT_WORD_BITS;
+        unsigned off = bit % BIGINT_WORD_BITS;
+        uint64_t v = l[j];
+        while (v && wi < k) {
+            w[wi] |= (bigIntWord_t)(v << off);
+            unsigned used = BIGINT_WORD_BITS - off;
+            v = (used >= 64) ? 0 : v >> used;
+            off = 0;
+            wi++;
+        }
+    }
+}
+
+/**
+ * Converts the Montgomery context's modulus and R'^2 mod n into kernel limbs.
+ *
+ * @param ctx Pointer to a context whose n/length are already set.
+ * @param kernel Vector kernel to prepare (must be supported).
+ * @param limbs Limb count L (multiple of 4, radix * L >= bits(n) + 2).
+ * @param rr R'^2 mod n as words.
+ * @param rr_len Length of rr in words.
+ */
+void bigint_simd_setup(bigIntMontCtx_t *ctx, bigIntKernel_t kernel, size_t limbs,
+                       const bigIntWord_t *rr, size_t rr_len) {
+    unsigned radix = bigint_simd_radix(kernel);
+    bigint_simd_split(ctx->simd_n, limbs, radix, ctx->n, ctx->length);
+    bigint_simd_split(ctx->simd_rr, limbs, radix, rr, rr_len);
+
+    // -n^-1 mod 2^radix by Newton iteration, as in bigint_mont_init
+    uint64_t n0 = ctx->simd_n[0];
+    uint64_t inv = n0;
+    for (int bits = 3; bits < 64; bits *= 2) {
+        inv *= 2 - n0 * inv;
+    }
+    ctx->simd_k0 = (0 - inv) & (((uint64_t)1 << radix) - 1);
+    ctx->simd_limbs = (uint32_t)limbs;
+    ctx->kernel = kernel;
+}
+
+/**
+ * Left-to-right exponentiation by a single word on the context's vector
+ * kernel, from ordinary form to ordinary form.
+ *
+ * @param x Output, ctx->length words, at most n.
+ * @param b Base below n, ctx->length words.
+ * @param e Exponent (nonzero).
+ * @param ctx Pointer to a context prepared by bigint_simd_setup.
+ * @param t Scratch of 3 * ctx->simd_limbs limbs.
+ */
+void bigint_simd_mont_exp_word(bigIntWord_t *x, const bigIntWord_t *b, bigIntWord_t e,
+                               const bigIntMontCtx_t *ctx, uint64_t *t) {
+    size_t limbs = ctx->simd_limbs;
+    unsigned radix = bigint_simd_radix(ctx->kernel);
+    bigint_amm_fn amm = (ctx->kernel == BIGINT_KERNEL_IFMA) ? bigint_amm52 : bigint_amm29;
+    const uint64_t *n = ctx->simd_n;
+    uint64_t k0 = ctx->simd_k0;
+    uint64_t *bm = t, *xm = t + limbs, *one = t + 2 * limbs;
+    memset(one, 0, limbs * sizeof(uint64_t));
+    one[0] = 1;
+
+    // Into the domain: b * R'^2 / R' = b * R'
+    bigint_simd_split(xm, limbs, radix, b, ctx->length);
+    amm(bm, xm, ctx->simd_rr, n, k0, limbs);
+
+    int bit = BIGINT_WORD_BITS - 1;
+    while (!((e >> bit) & 1)) bit--;
+    memcpy(xm, bm, limbs * sizeof(uint64_t));
+    while (bit-- > 0) {
+        amm(xm, xm, xm, n, k0, limbs);
+        if ((e >> bit) & 1) {
+            amm(xm, xm, bm, n, k0, limbs);
+        }
+    }
+
+    // Out of the domain: x * 1 / R' <= n
+    amm(xm, xm, one, n, k0, limbs);
+    bigint_simd_join(x, ctx->length, xm, limbs, radix);
+}
+
+
+// ---------------------------------------------------------------------------
+// Multi-buffer exponentiation
+//
+// Independent exponentiations under one modulus run in lockstep, one per
+// 64-bit lane: limb j of lane l sits at [j * lanes + l] (struct of arrays),
+// so every vector instruction advances all lanes by the same limb. The
+// accumulator is indexed from the current step (acc[i + j]) instead of being
+// shifted, which in this layout needs no lane shuffles at all.
+// ---------------------------------------------------------------------------
+
+// Limbs for the largest modulus in radix 2^52 (IFMA lanes)
+#define BIGINT_SIMD_MAX_LIMBS52 ((((BIGINT_MAX_MOD_BITS) + 2 + 51) / 52 + 3) & ~3)
+
+/*
+ * Eight lanes of r = a * b / 2^(52L) mod n (< 2n) with 512-bit IFMA. b == NULL
+ * stands for b = 1 in every lane. acc needs 2L + 1 vectors.
+ */
+BIGINT_IFMA_TARGET
+static void bigint_amm52x8(__m512i *r, const __m512i *a, const __m512i *b, const uint64_t *n,
+                           uint64_t k0, size_t limbs, __m512i *acc) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i kv = _mm512_set1_epi64((long long)k0);
+    const __m512i one = _mm512_set1_epi64(1);
+
+    for (size_t j = 0; j <= 2 * limbs; j++) acc[j] = zero;
+
+    for (size_t i = 0; i < limbs; i++) {
+        __m512i bi = b ? b[i] : (i == 0 ? one : zero);
+        __m512i *t = acc + i;
+        if (b) {
+            for (size_t j = 0; j < limbs; j++) {
+                t[j] = _mm512_madd52lo_epu64(t[j], a[j], bi);
+                t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], a[j], bi);
+            }
+        } else if (i == 0) {
+            for (size_t j = 0; j < limbs; j++) t[j] = _mm512_add_epi64(t[j], a[j]);
+        }
+
+        __m512i y = _mm512_madd52lo_epu64(zero, t[0], kv);
+        for (size_t j = 0; j < limbs; j++) {
+            __m512i nj = _mm512_set1_epi64((long long)n[j]);
+            t[j] = _mm512_madd52lo_epu64(t[j], nj, y);
+            t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], nj, y);
+        }
+        t[1] = _mm512_add_epi64(t[1], _mm512_srli_epi64(t[0], 52));
+    }
+
+    const __m512i mask = _mm512_set1_epi64((1LL << 52) - 1);
+    __m512i carry = zero;
+    for (size_t j = 0; j < limbs; j++) {
+        __m512i v = _mm512_add_epi64(acc[limbs + j], carry);
+        r[j] = _mm512_and_si512(v, mask);
+        carry = _mm512_srli_epi64(v, 52);
+    }
+}
+
+/*
+ * Four lanes of r = a * b / 2^(29L) mod n (< 2n) with AVX2. The window of live
+ * accumulator limbs is carried every 8 steps, as in bigint_amm29.
+ */
+BIGINT_AVX2_TARGET
+static void bigint_amm29x4(__m256i *r, const __m256i *a, const __m256i *b, const uint64_t *n,
+                           uint64_t k0, size_t limbs, __m256i *acc) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i kv = _mm256_set1_epi64x((long long)k0);
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i mask = _mm256_set1_epi64x((1 << 29) - 1);
+
+    for (size_t j = 0; j <= 2 * limbs; j++) acc[j] = zero;
+
+    for (size_t i = 0; i < limbs; i++) {
+        __m256i bi = b ? b[i] : (i == 0 ? one : zero);
+        __m256i *t = acc + i;
+        for (size_t j = 0; j < limbs; j++) {
+            t[j] = _mm256_add_epi64(t[j], _mm256_mul_epu32(a[j], bi));
+        }
+
+        __m256i y = _mm256_and_si256(_mm256_mul_epu32(t[0], kv), mask);
+        for (size_t j = 0; j < limbs; j++) {
+            __m256i nj = _mm256_set1_epi64x((long long)n[j]);
+            t[j] = _mm256_add_epi64(t[j], _mm256_mul_epu32(nj, y));
+        }
+        t[1] = _mm256_add_epi64(t[1], _mm256_srli_epi64(t[0], 29));
+
+        if ((i & 7) == 7) {
+            for (size_t j = 1; j < limbs; j++) {
+                t[j + 1] = _mm256_add_epi64(t[j + 1], _mm256_srli_epi64(t[j], 29));
+                t[j] = _mm256_and_si256(t[j], mask);
+            }
+        }
+    }
+
+    __m256i carry = zero;
+    for (size_t j = 0; j < limbs; j++) {
+        __m256i v = _mm256_add_epi64(acc[limbs + j], carry);
+        r[j] = _mm256_and_si256(v, mask);
+        carry = _mm256_srli_epi64(v, 29);
+    }
+}
+
+// Same bit scan as bigint_simd_mont_exp_word, all lanes at once (b is in
+// ordinary form, x comes back in ordinary form, both in lane layout)
+BIGINT_IFMA_TARGET
+static void bigint_exp52x8(__m512i *x, const __m512i *b, bigIntWord_t e, const bigIntMontCtx_t *ctx) {
+    size_t limbs = ctx->simd_limbs;
+    __m512i acc[2 * BIGINT_SIMD_MAX_LIMBS52 + 1];
+    __m512i bm[BIGINT_SIMD_MAX_LIMBS52], rr[BIGINT_SIMD_MAX_LIMBS52];
+
+    for (size_t j = 0; j < limbs; j++) rr[j] = _mm512_set1_epi64((long long)ctx->simd_rr[j]);
+    bigint_amm52x8(bm, b, rr, ctx->simd_n, ctx->simd_k0, limbs, acc);
+
+    int bit = BIGINT_WORD_BITS - 1;
+    while (!((e >> bit) & 1)) bit--;
+    memcpy(x, bm, limbs * sizeof(__m512i));
+    while (bit-- > 0) {
+        bigint_amm52x8(x, x, x, ctx->simd_n, ctx->simd_k0, limbs, acc);
+        if ((e >> bit) & 1) {
+            bigint_amm52x8(x, x, bm, ctx->simd_n, ctx->simd_k0, limbs, acc);
+        }
+    }
+    bigint_amm52x8(x, x, NULL, ctx->simd_n, ctx->simd_k0, limbs, acc);
+}
+
+BIGINT_AVX2_TARGET
+static void bigint_exp29x4(__m256i *x, const __m256i *b, bigIntWord_t e, const bigIntMontCtx_t *ctx) {
+    size_t limbs = ctx->simd_limbs;
+    __m256i acc[2 * BIGINT_SIMD_MAX_LIMBS + 1];
+    __m256i bm[BIGINT_SIMD_MAX_LIMBS], rr[BIGINT_SIMD_MAX_LIMBS];
+
+    for (size_t j = 0; j < limbs; j++) rr[j] = _mm256_set1_epi64x((long long)ctx->simd_rr[j]);
+    bigint_amm29x4(bm, b, rr, ctx->simd_n, ctx->simd_k0, limbs, acc);
+
+    int bit = BIGINT_WORD_BITS - 1;
+    while (!((e >> bit) & 1)) bit--;
+    memcpy(x, bm, limbs * sizeof(__m256i));
+    while (bit-- > 0) {
+        bigint_amm29x4(x, x, x, ctx->simd_n, ctx->simd_k0, limbs, acc);
+        if ((e >> bit) & 1) {
+            bigint_amm29x4(x, x, bm, ctx->simd_n, ctx->simd_k0, limbs, acc);
+        }
+    }
+    bigint_amm29x4(x, x, NULL, ctx->simd_n, ctx->simd_k0, limbs, acc);
+}
+
+/**
+ * Number of exponentiations bigint_simd_mont_exp_word_batch runs at once.
+ *
+ * @param kernel Vector kernel of the context.
+ * @return 8 for IFMA (512-bit), 4 for AVX2, 1 otherwise.
+ */
+size_t bigint_simd_batch_lanes(bigIntKernel_t kernel) {
+    switch (kernel) {
+    case BIGINT_KERNEL_IFMA: return 8;
+    case BIGINT_KERNEL_AVX2: return 4;
+    default: return 1;
+    }
+}
+
+/**
+ * Runs up to bigint_simd_batch_lanes() single-word exponentiations under the
+ * context's modulus side by side, x[l] = b[l]^e mod n.
+ *
+ * @param x Outputs, ctx->length words each, at most n.
+ * @param b Bases below n, ctx->length words each.
+ * @param count Number of exponentiations (1 .. lanes; spare lanes idle on 0).
+ * @param e Exponent (nonzero), shared by all lanes.
+ * @param ctx Pointer to a context prepared by bigint_simd_setup.
+ */
+void bigint_simd_mont_exp_word_batch(bigIntWord_t *const x[], const bigIntWord_t *const b[],
+                                     size_t count, bigIntWord_t e, const bigIntMontCtx_t *ctx) {
+    size_t lanes = bigint_simd_batch_lanes(ctx->kernel);
+    size_t limbs = ctx->simd_limbs;
+    unsigned radix = bigint_simd_radix(ctx->kernel);
+    uint64_t limb[BIGINT_SIMD_MAX_LIMBS];
+
+    // Lane layout; 64-byte alignment covers both vector widths
+    __attribute__((aligned(64))) uint64_t soa[BIGINT_SIMD_MAX_LIMBS * 4 > BIGINT_SIMD_MAX_LIMBS52 * 8 ?
+                                              BIGINT_SIMD_MAX_LIMBS * 4 : BIGINT_SIMD_MAX_LIMBS52 * 8];
+    memset(soa, 0, limbs * lanes * sizeof(uint64_t));
+    for (size_t l = 0; l < count; l++) {
+        bigint_simd_split(limb, limbs, radix, b[l], ctx->length);
+        for (size_t j = 0; j < limbs; j++) soa[j * lanes + l] = limb[j];
+    }
+
+    if (ctx->kernel == BIGINT_KERNEL_IFMA) {
+        bigint_exp52x8((__m512i *)soa, (const __m512i *)soa, e, ctx);
+    } else {
+        bigint_exp29x4((__m256i *)soa, (const __m256i *)soa, e, ctx);
+    }
+
+    for (size_t l = 0; l < count; l++) {
+        for (size_t j = 0; j < limbs; j++) limb[j] = soa[j * lanes + l];
+        bigint_simd_join(x[l], ctx->length, limb, limbs, radix);
+    }
+}
+
+#endif // BIGINT_SIMD
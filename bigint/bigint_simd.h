@@ -0,0 +1,28 @@
+#ifndef BIG_INT_SIMD_H
+#define BIG_INT_SIMD_H
+
+// Internal interface between bigint.c and the vector kernels in bigint_simd.c
+
+#include "bigint.h"
+
+#if BIGINT_SIMD
+bool bigint_simd_supported(bigIntKernel_t kernel);
+unsigned bigint_simd_radix(bigIntKernel_t kernel);
+
+// Fills the simd_* fields of ctx for the kernel, given R'^2 mod n as rr[0..rr_len)
+void bigint_simd_setup(bigIntMontCtx_t *ctx, bigIntKernel_t kernel, size_t limbs,
+                       const bigIntWord_t *rr, size_t rr_len);
+
+// x = b^e mod n for a nonzero exponent and b < n (ordinary, not Montgomery
+// form), both ctx->length words. The result is at most n, not fully reduced.
+// t: 3 * ctx->simd_limbs limbs of scratch (BIGINT_SIMD_SCRATCH words).
+void bigint_simd_mont_exp_word(bigIntWord_t *x, const bigIntWord_t *b, bigIntWord_t e,
+                               const bigIntMontCtx_t *ctx, uint64_t *t);
+
+// Up to bigint_simd_batch_lanes() of the above with one exponent, in SIMD lanes
+size_t bigint_simd_batch_lanes(bigIntKernel_t kernel);
+void bigint_simd_mont_exp_word_batch(bigIntWord_t *const x[], const bigIntWord_t *const b[],
+                                     size_t count, bigIntWord_t e, const bigIntMontCtx_t *ctx);
+#endif
+
+#endif // BIG_INT_SIMD_H
@@ -0,0 +1,7 @@
+
+src="bench-rsa-batch.c sha256\sha256.c sha512\sha512.c rsakeys\rsa_keys.c rsa2048\rsa2048.c rsa2048\rsa_manifest.c rsa2048\rsa_pool.c bigint\bigint.c bigint\bigint_simd.c"
+inc="-I sha256 -I sha512 -I rsakeys -I rsa2048 -I bigint"
+out="bench-rsa-batch"
+flag="-O2"
+lib="-lpthread"
+gcc $flag -o $out $src $inc $lib
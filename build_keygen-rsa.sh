@@ -0,0 +1,6 @@
+src="keygen-rsa.c sha256\sha256.c sha512\sha512.c rsa2048\rsa_keygen.c bigint\bigint.c bigint\bigint_simd.c"
+inc="-I sha256 -I sha512 -I rsa2048 -I bigint"
+out="keygen-rsa"
+flag="-O2"
+lib="-lpthread"
+gcc $flag -o $out $src $inc $lib
@@ -0,0 +1,6 @@
+src="test-bigint.c bigint\bigint.c bigint\bigint_simd.c"
+inc="-I bigint"
+out="test-bigint"
+flag="-O2"
+lib=""
+gcc $flag -o $out $src $inc $lib
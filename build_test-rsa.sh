@@ -1,6 +1,7 @@
 
-src="test-rsa.c sha256\sha256.c rsakeys\rsa_keys.c rsa2048\rsa2048.c bigint\bigint.c"
-inc="-I sha256 -I rsakeys -I rsa2048 -I bigint"
+src="test-rsa.c sha256\sha256.c sha512\sha512.c rsakeys\rsa_keys.c rsa2048\rsa2048.c rsa2048\rsa_keyring.c rsa2048\rsa_keygen.c rsa2048\rsa_manifest.c rsa2048\rsa_file.c rsa2048\rsa_pool.c rsa2048\rsa_cache.c bigint\bigint.c bigint\bigint_simd.c"
+inc="-I sha256 -I sha512 -I rsakeys -I rsa2048 -I bigint"
 out="test-rsa"
 flag="-Os -flto -ffunction-sections -fdata-sections -Wl,--gc-section"
-gcc $flag -o $out $src $inc
\ No newline at end of file
+lib="-lpthread"
+gcc $flag -o $out $src $inc $lib
\ No newline at end of file
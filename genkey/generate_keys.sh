@@ -16,6 +16,14 @@ openssl dgst -sha256 -sign private_key.pem -out firmware.sig firmware.bin
 echo "Verifying signature..."
 openssl dgst -sha256 -verify public_key.pem -signature firmware.sig firmware.bin
 
+# Same image signed with SHA-512 (the verifier reads the digest from the signature)
+openssl dgst -sha512 -sign private_key.pem -out firmware_sha512.sig firmware.bin
+
+# Chunked manifest (Merkle root over 64 KiB chunks); only its 56-byte header is signed
+echo "Building and signing firmware manifest..."
+python3 make_manifest.py firmware.bin manifest.bin 65536
+head -c 56 manifest.bin | openssl dgst -sha256 -sign private_key.pem -out manifest.sig
+
 # Extract modulus and public exponent in hex format
 echo "Extracting modulus and exponent..."
 openssl rsa -in public_key.pem -pubin -text -noout > key_info.txt
@@ -32,5 +40,7 @@ echo "Done! Files created:"
 echo "- private_key.pem: RSA private key"
 echo "- public_key.pem: RSA public key"  
 echo "- firmware.sig: Signature file"
+echo "- firmware_sha512.sig: Signature file (SHA-512)"
+echo "- manifest.bin / manifest.sig: Chunked manifest and its signature"
 echo "- modulus.hex: Modulus in hex"
 echo "- exponent.txt: Public exponent"
\ No newline at end of file
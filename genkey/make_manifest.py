@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Build the chunked firmware manifest (rsa2048/rsa_manifest.h).
+
+The image is split into fixed-size chunks whose digests form a Merkle tree.
+The signature covers only the fixed header, which ends with the tree root:
+
+    python3 make_manifest.py firmware.bin manifest.bin [chunk_size]
+    head -c 56 manifest.bin | openssl dgst -sha256 -sign private_key.pem -out manifest.sig
+"""
+import hashlib
+import struct
+import sys
+
+MAGIC = b"FWMF"
+VERSION = 1
+HEADER_SIZE = 56
+DEFAULT_CHUNK_SIZE = 64 * 1024
+
+def leaf_hash(chunk):
+    return hashlib.sha256(b"\x00" + chunk).digest()
+
+def node_hash(left, right):
+    return hashlib.sha256(b"\x01" + left + right).digest()
+
+def merkle_root(leaves):
+    level = list(leaves)
+    while len(level) > 1:
+        # A node without a partner moves up unchanged
+        nxt = [node_hash(level[i], level[i + 1]) for i in range(0, len(level) - 1, 2)]
+        if len(level) % 2:
+            nxt.append(level[-1])
+        level = nxt
+    return level[0]
+
+def build_manifest(image, chunk_size):
+    if not image:
+        raise ValueError("empty image")
+    if not 0 < chunk_size < 2**32:
+        raise ValueError("chunk size out of range")
+    leaves = [leaf_hash(image[i:i + chunk_size]) for i in range(0, len(image), chunk_size)]
+    header = MAGIC + struct.pack(">III", VERSION, chunk_size, len(leaves))
+    header += struct.pack(">Q", len(image)) + merkle_root(leaves)
+    assert len(header) == HEADER_SIZE
+    return header + b"".join(leaves)
+
+def main():
+    if len(sys.argv) not in (3, 4):
+        print(f"usage: {sys.argv[0]} <image> <manifest> [chunk_size]")
+        return 1
+    chunk_size = int(sys.argv[3], 0) if len(sys.argv) == 4 else DEFAULT_CHUNK_SIZE
+    with open(sys.argv[1], 'rb') as f:
+        image = f.read()
+    try:
+        manifest = build_manifest(image, chunk_size)
+    except ValueError as e:
+        print(f"❌ {e}")
+        return 1
+    with open(sys.argv[2], 'wb') as f:
+        f.write(manifest)
+    print(f"✅ {sys.argv[2]}: {len(image)} bytes in {(len(manifest) - HEADER_SIZE) // 32} chunks of {chunk_size}")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -3,45 +3,476 @@
 #include "rsa2048.h"
 #include <stdio.h>
 #include "rsa_keys.h"
-rsa_verify_result_t rsa_verify_signature(
-    const uint8_t *message, size_t message_len,
-    const uint8_t *signature, size_t sig_len,
+
+// The embedded key is set up with pthread_once; -DRSA_THREAD_SAFE=0 drops
+// that (and the pthread dependency) for single-threaded bootloader builds
+#ifndef RSA_THREAD_SAFE
+#define RSA_THREAD_SAFE 1
+#endif
+#if RSA_THREAD_SAFE
+#include <pthread.h>
+#endif
+
+static rsa_verify_result_t rsa_check_pkcs1(
+    const uint8_t *decrypted, size_t mod_len,
+    rsa_hash_alg_t *alg, const uint8_t **digest
+);
+
+// DigestInfo prefix and digest length of each rsa_hash_alg_t
+static const struct {
+    const uint8_t *prefix;
+    size_t prefix_len;
+    size_t digest_len;
+} rsa_digest_info[] = {
+    [RSA_HASH_SHA256] = { RSA_PKCS1_SHA256_PREFIX, RSA_PKCS1_SHA256_PREFIX_LEN, SHA256_DIGEST_SIZE },
+    [RSA_HASH_SHA384] = { RSA_PKCS1_SHA384_PREFIX, RSA_PKCS1_SHA384_PREFIX_LEN, SHA384_DIGEST_SIZE },
+    [RSA_HASH_SHA512] = { RSA_PKCS1_SHA512_PREFIX, RSA_PKCS1_SHA512_PREFIX_LEN, SHA512_DIGEST_SIZE },
+};
+#define RSA_HASH_ALG_COUNT (sizeof(rsa_digest_info) / sizeof(rsa_digest_info[0]))
+
+static void rsa_hash_message(rsa_hash_alg_t alg, const uint8_t *message, size_t len, uint8_t *digest) {
+    switch (alg) {
+        case RSA_HASH_SHA384: sha384_hash(message, len, digest); break;
+        case RSA_HASH_SHA512: sha512_hash(message, len, digest); break;
+        default:              sha256_hash(message, len, digest); break;
+    }
+}
+
+// RFC 8017 (RSAVP1): a signature representative must lie below the modulus
+static bool rsa_signature_in_range(const rsa_public_key_t *key, const bigInt_t *sig) {
+    bigInt_t n = { (bigIntWord_t *)key->mont.n, key->mont.length, BIGINT_MAX_MOD_WORDS };
+    return bigint_compare(sig, &n) < 0;
+}
+
+rsa_verify_result_t rsa_public_key_init(
+    rsa_public_key_t *key,
     const uint8_t *modulus, size_t mod_len,
     uint32_t exponent
 ) {
-    bigInt_t sig_bigint, mod_bigint, exp_bigint, result_bigint;
-    bigIntStatus_t status;
+    BIGINT_DEFINE(mod_bigint, BIGINT_MAX_MOD_WORDS);
+    if (!key || !modulus || mod_len < RSA_MIN_MODULUS_BYTES || mod_len > RSA_MAX_MODULUS_BYTES) {
+        return RSA_VERIFY_ERROR;
+    }
+
+    // Convert modulus to bigint (big-endian)
+    if (bigint_from_bytes(&mod_bigint, modulus, mod_len) != BIGINT_OK) {
+        return RSA_VERIFY_ERROR;
+    }
+
+    // RSA moduli are odd, so the Montgomery constants always exist
+    if (bigint_mont_init(&key->mont, &mod_bigint) != BIGINT_OK) {
+        return RSA_VERIFY_ERROR;
+    }
+
+    // Bit length from the first nonzero byte; no PKCS#1 block fits in a
+    // modulus shorter than RSA_MIN_MODULUS_BYTES
+    size_t lead = 0;
+    while (modulus[lead] == 0) lead++;   // mont_init rejected a zero modulus
+    if (mod_len - lead < RSA_MIN_MODULUS_BYTES) {
+        return RSA_VERIFY_ERROR;
+    }
+    uint32_t bits = (uint32_t)(mod_len - lead) * 8;
+    for (uint8_t top = modulus[lead]; !(top & 0x80); top <<= 1) bits--;
+
+    key->mod_len = mod_len;
+    key->bits = bits;
+    key->exponent = exponent;
+    return RSA_VERIFY_OK;
+}
+
+size_t rsa_verify_workspace_size(const rsa_public_key_t *key) {
+    return key ? RSA_VERIFY_WORKSPACE_SIZE(key->mod_len) : 0;
+}
+
+// RSA public-key operation on a signature: leaves the decoded block
+// (key->mod_len bytes, leading zeros kept) in the workspace
+static rsa_verify_result_t rsa_public_op_ws(
+    const rsa_public_key_t *key,
+    const uint8_t *signature, size_t sig_len,
+    void *workspace, size_t workspace_size,
+    const uint8_t **decoded
+) {
     // Validate inputs
-    if (!message || !signature || !modulus || 
-        message_len == 0 || sig_len != mod_len) {
+    if (!key || !signature || !workspace || sig_len != key->mod_len ||
+        workspace_size < RSA_VERIFY_WORKSPACE_SIZE(key->mod_len) ||
+        ((uintptr_t)workspace & (RSA_WORKSPACE_ALIGN - 1))) {
         return RSA_VERIFY_ERROR;
     }
+    size_t mod_len = key->mod_len;
+    size_t words = RSA_MODULUS_WORDS(mod_len);
+
+    // Workspace: exponentiation scratch, signature, result, decoded block
+    bigIntWord_t *scratch = (bigIntWord_t *)workspace;
+    bigIntWord_t *sig_words = scratch + BIGINT_MONT_EXP_UINT_SCRATCH(words);
+    bigIntWord_t *result_words = sig_words + BIGINT_SCRATCH_ROUND(words);
+    uint8_t *decrypted = (uint8_t *)(result_words + BIGINT_SCRATCH_ROUND(words));
+    bigInt_t sig_bigint, result_bigint;
+    bigIntStatus_t status;
+    bigint_init(&sig_bigint, sig_words, words);
+    bigint_init(&result_bigint, result_words, words);
 
     // Convert signature to bigint (big-endian)
     status = bigint_from_bytes(&sig_bigint, signature, sig_len);
     if (status != BIGINT_OK) return RSA_VERIFY_ERROR;
-    
-    // Convert modulus to bigint (big-endian) 
-    status = bigint_from_bytes(&mod_bigint, modulus, mod_len);
-    if (status != BIGINT_OK) return RSA_VERIFY_ERROR;
-    
-    // Convert exponent to bigint
-    status = bigint_from_uint32(&exp_bigint, exponent);
-    if (status != BIGINT_OK) return RSA_VERIFY_ERROR;
-    
+    if (!rsa_signature_in_range(key, &sig_bigint)) return RSA_VERIFY_INVALID_SIGNATURE;
+
     // Perform RSA public key operation: signature^exponent mod modulus
-    status = bigint_mod_exp(&result_bigint, &sig_bigint, &exp_bigint, &mod_bigint);
+    // (single-word exponent: plain bit scan, no exponent bigint)
+    status = bigint_mont_exp_uint_ws(&result_bigint, &sig_bigint, key->exponent, &key->mont, scratch);
 
     if (status != BIGINT_OK) return RSA_VERIFY_ERROR;
     
     
     // Convert result back to bytes with FIXED LENGTH
-    uint8_t decrypted[256];
     status = bigint_to_bytes(&result_bigint, decrypted, mod_len);
     if (status != BIGINT_OK) return RSA_VERIFY_ERROR;
-    
-    // Now decrypted has exactly mod_len bytes with leading zeros if needed
-    // Verify PKCS#1 v1.5 padding for SHA-256
+
+    *decoded = decrypted;
+    return RSA_VERIFY_OK;
+}
+
+// Verification on an already computed digest of the given algorithm
+static rsa_verify_result_t rsa_verify_digest_ws(
+    const rsa_public_key_t *key,
+    rsa_hash_alg_t alg, const uint8_t *message_hash,
+    const uint8_t *signature, size_t sig_len,
+    void *workspace, size_t workspace_size
+) {
+    const uint8_t *decrypted, *sig_hash;
+    rsa_hash_alg_t sig_alg;
+    rsa_verify_result_t result = rsa_public_op_ws(key, signature, sig_len, workspace, workspace_size, &decrypted);
+    if (result != RSA_VERIFY_OK) return result;
+    result = rsa_check_pkcs1(decrypted, key->mod_len, &sig_alg, &sig_hash);
+    if (result != RSA_VERIFY_OK) return result;
+    if (sig_alg != alg) return RSA_VERIFY_PADDING_ERROR;   // signed with another digest
+
+    // Compare hashes
+    if (memcmp(sig_hash, message_hash, rsa_digest_info[alg].digest_len) == 0) {
+        return RSA_VERIFY_OK;
+    } else {
+        return RSA_VERIFY_INVALID_SIGNATURE;
+    }
+}
+
+rsa_verify_result_t rsa_verify_with_key_ws(
+    const rsa_public_key_t *key,
+    const uint8_t *message, size_t message_len,
+    const uint8_t *signature, size_t sig_len,
+    void *workspace, size_t workspace_size
+) {
+    if (!message || message_len == 0) {
+        return RSA_VERIFY_ERROR;
+    }
+    // The digest to compute is only known once the signature is decoded
+    const uint8_t *decrypted, *sig_hash;
+    rsa_hash_alg_t alg;
+    rsa_verify_result_t result = rsa_public_op_ws(key, signature, sig_len, workspace, workspace_size, &decrypted);
+    if (result != RSA_VERIFY_OK) return result;
+    result = rsa_check_pkcs1(decrypted, key->mod_len, &alg, &sig_hash);
+    if (result != RSA_VERIFY_OK) return result;
+
+    uint8_t message_hash[RSA_MAX_DIGEST_SIZE];
+    rsa_hash_message(alg, message, message_len, message_hash);
+    if (memcmp(sig_hash, message_hash, rsa_digest_info[alg].digest_len) == 0) {
+        return RSA_VERIFY_OK;
+    } else {
+        return RSA_VERIFY_INVALID_SIGNATURE;
+    }
+}
+
+rsa_verify_result_t rsa_signature_hash_alg(
+    const rsa_public_key_t *key,
+    const uint8_t *signature, size_t sig_len,
+    rsa_hash_alg_t *alg,
+    uint8_t digest[RSA_MAX_DIGEST_SIZE]
+) {
+    _Alignas(RSA_WORKSPACE_ALIGN) uint8_t workspace[RSA_VERIFY_WORKSPACE_MAX];
+    const uint8_t *decrypted, *sig_hash;
+    if (!alg) {
+        return RSA_VERIFY_ERROR;
+    }
+    rsa_verify_result_t result = rsa_public_op_ws(key, signature, sig_len, workspace, sizeof(workspace), &decrypted);
+    if (result != RSA_VERIFY_OK) return result;
+    result = rsa_check_pkcs1(decrypted, key->mod_len, alg, &sig_hash);
+    if (result == RSA_VERIFY_OK && digest) {
+        memset(digest, 0, RSA_MAX_DIGEST_SIZE);
+        memcpy(digest, sig_hash, rsa_digest_info[*alg].digest_len);
+    }
+    return result;
+}
+
+rsa_verify_result_t rsa_verify_with_key(
+    const rsa_public_key_t *key,
+    const uint8_t *message, size_t message_len,
+    const uint8_t *signature, size_t sig_len
+) {
+    _Alignas(RSA_WORKSPACE_ALIGN) uint8_t workspace[RSA_VERIFY_WORKSPACE_MAX];
+    return rsa_verify_with_key_ws(key, message, message_len, signature, sig_len,
+                                  workspace, sizeof(workspace));
+}
+
+rsa_verify_result_t rsa_verify_init(rsa_verify_ctx_t *ctx, const rsa_public_key_t *key) {
+    return rsa_verify_init_hash(ctx, key, RSA_HASH_SHA256);
+}
+
+rsa_verify_result_t rsa_verify_init_hash(rsa_verify_ctx_t *ctx, const rsa_public_key_t *key, rsa_hash_alg_t alg) {
+    if (!ctx || !key || (unsigned)alg >= RSA_HASH_ALG_COUNT) {
+        return RSA_VERIFY_ERROR;
+    }
+    ctx->key = key;
+    ctx->alg = alg;
+    switch (alg) {
+        case RSA_HASH_SHA384: sha384_init(&ctx->sha512); break;
+        case RSA_HASH_SHA512: sha512_init(&ctx->sha512); break;
+        default:              sha256_init(&ctx->sha); break;
+    }
+    return RSA_VERIFY_OK;
+}
+
+void rsa_verify_update(rsa_verify_ctx_t *ctx, const uint8_t *data, size_t len) {
+    if (ctx && data && len > 0) {
+        if (ctx->alg == RSA_HASH_SHA256) {
+            sha256_update(&ctx->sha, data, len);
+        } else {
+            sha512_update(&ctx->sha512, data, len);
+        }
+    }
+}
+
+rsa_verify_result_t rsa_verify_checkpoint(const rsa_verify_ctx_t *ctx, uint8_t checkpoint[SHA256_CHECKPOINT_SIZE]) {
+    if (!ctx || !ctx->key || !checkpoint || ctx->alg != RSA_HASH_SHA256) {
+        return RSA_VERIFY_ERROR;
+    }
+    sha256_export(&ctx->sha, checkpoint);
+    return RSA_VERIFY_OK;
+}
+
+rsa_verify_result_t rsa_verify_resume(
+    rsa_verify_ctx_t *ctx, const rsa_public_key_t *key,
+    const uint8_t checkpoint[SHA256_CHECKPOINT_SIZE], uint64_t *offset
+) {
+    if (!ctx || !key || !checkpoint) {
+        return RSA_VERIFY_ERROR;
+    }
+    if (sha256_import(&ctx->sha, checkpoint) != 0) {
+        ctx->key = NULL;
+        return RSA_VERIFY_ERROR;
+    }
+    ctx->key = key;
+    ctx->alg = RSA_HASH_SHA256;
+    if (offset) *offset = ctx->sha.count;
+    return RSA_VERIFY_OK;
+}
+
+// Ends the hashing of a streaming verification; the context is finished after it
+static rsa_verify_result_t rsa_verify_finish_hash(rsa_verify_ctx_t *ctx, uint8_t message_hash[RSA_MAX_DIGEST_SIZE]) {
+    if (!ctx || !ctx->key || !message_hash) {
+        return RSA_VERIFY_ERROR;
+    }
+    // An empty message is an error, as with rsa_verify_with_key
+    uint64_t count = (ctx->alg == RSA_HASH_SHA256) ? ctx->sha.count : ctx->sha512.count;
+    if (count == 0) {
+        return RSA_VERIFY_ERROR;
+    }
+    switch (ctx->alg) {
+        case RSA_HASH_SHA384: sha384_final(&ctx->sha512, message_hash); break;
+        case RSA_HASH_SHA512: sha512_final(&ctx->sha512, message_hash); break;
+        default:              sha256_final(&ctx->sha, message_hash); break;
+    }
+    ctx->key = NULL;    // finished: needs a new rsa_verify_init
+    return RSA_VERIFY_OK;
+}
+
+rsa_verify_result_t rsa_verify_final(rsa_verify_ctx_t *ctx, const uint8_t *signature, size_t sig_len) {
+    uint8_t message_hash[RSA_MAX_DIGEST_SIZE];
+    return rsa_verify_final_digest(ctx, signature, sig_len, message_hash);
+}
+
+rsa_verify_result_t rsa_verify_final_digest(
+    rsa_verify_ctx_t *ctx,
+    const uint8_t *signature, size_t sig_len,
+    uint8_t message_hash[RSA_MAX_DIGEST_SIZE]
+) {
+    _Alignas(RSA_WORKSPACE_ALIGN) uint8_t workspace[RSA_VERIFY_WORKSPACE_MAX];
+    const rsa_public_key_t *key = ctx ? ctx->key : NULL;
+    rsa_verify_result_t result = rsa_verify_finish_hash(ctx, message_hash);
+    if (result != RSA_VERIFY_OK) return result;
+    return rsa_verify_digest_ws(key, ctx->alg, message_hash, signature, sig_len, workspace, sizeof(workspace));
+}
+
+rsa_verify_result_t rsa_verify_final_expected(
+    rsa_verify_ctx_t *ctx,
+    const uint8_t expected[RSA_MAX_DIGEST_SIZE],
+    uint8_t message_hash[RSA_MAX_DIGEST_SIZE]
+) {
+    if (!expected) {
+        return RSA_VERIFY_ERROR;
+    }
+    rsa_verify_result_t result = rsa_verify_finish_hash(ctx, message_hash);
+    if (result != RSA_VERIFY_OK) return result;
+    if (memcmp(expected, message_hash, rsa_digest_info[ctx->alg].digest_len) == 0) {
+        return RSA_VERIFY_OK;
+    } else {
+        return RSA_VERIFY_INVALID_SIGNATURE;
+    }
+}
+
+rsa_verify_result_t rsa_verify_signature(
+    const uint8_t *message, size_t message_len,
+    const uint8_t *signature, size_t sig_len,
+    const uint8_t *modulus, size_t mod_len,
+    uint32_t exponent
+) {
+    rsa_public_key_t key;
+    // Validate inputs
+    if (!message || !signature || !modulus ||
+        message_len == 0 || sig_len != mod_len) {
+        return RSA_VERIFY_ERROR;
+    }
+    if (rsa_public_key_init(&key, modulus, mod_len, exponent) != RSA_VERIFY_OK) {
+        return RSA_VERIFY_ERROR;
+    }
+    return rsa_verify_with_key(&key, message, message_len, signature, sig_len);
+}
+
+/**
+ * Verify many signatures made with the same public key. The RSA operations
+ * run side by side in SIMD lanes where the CPU allows (bigint_mont_exp_uint_batch).
+ */
+rsa_verify_result_t rsa_verify_signature_batch(
+    const rsa_verify_item_t *items, rsa_verify_result_t *results, size_t count,
+    const uint8_t *modulus, size_t mod_len,
+    uint32_t exponent
+) {
+    rsa_public_key_t key;
+    if (!items || !results || !modulus) {
+        return RSA_VERIFY_ERROR;
+    }
+    if (rsa_public_key_init(&key, modulus, mod_len, exponent) != RSA_VERIFY_OK) {
+        for (size_t i = 0; i < count; i++) results[i] = RSA_VERIFY_ERROR;
+        return RSA_VERIFY_ERROR;
+    }
+    return rsa_verify_batch_with_key(&key, items, results, count);
+}
+
+rsa_verify_result_t rsa_verify_batch_with_key(
+    const rsa_public_key_t *key,
+    const rsa_verify_item_t *items, rsa_verify_result_t *results, size_t count
+) {
+    _Alignas(RSA_WORKSPACE_ALIGN) uint8_t workspace[RSA_VERIFY_BATCH_WORKSPACE_MAX];
+    return rsa_verify_batch_with_key_ws(key, items, results, count, workspace, sizeof(workspace));
+}
+
+rsa_verify_result_t rsa_verify_batch_with_key_ws(
+    const rsa_public_key_t *key,
+    const rsa_verify_item_t *items, rsa_verify_result_t *results, size_t count,
+    void *workspace, size_t workspace_size
+) {
+    if (!key || !items || !results) {
+        return RSA_VERIFY_ERROR;
+    }
+    size_t mod_len = key->mod_len;
+    if (!workspace || workspace_size < RSA_VERIFY_BATCH_WORKSPACE_SIZE(mod_len) ||
+        ((uintptr_t)workspace & (RSA_WORKSPACE_ALIGN - 1))) {
+        for (size_t i = 0; i < count; i++) results[i] = RSA_VERIFY_ERROR;
+        return RSA_VERIFY_ERROR;
+    }
+    size_t words = RSA_MODULUS_WORDS(mod_len);
+    size_t stride = BIGINT_SCRATCH_ROUND(words);
+
+    // Workspace: signature operands, result operands, decoded block
+    bigIntWord_t *sig_words = (bigIntWord_t *)workspace;
+    bigIntWord_t *res_words = sig_words + RSA_VERIFY_BATCH_CHUNK * stride;
+    uint8_t *decrypted = (uint8_t *)(res_words + RSA_VERIFY_BATCH_CHUNK * stride);
+    bigInt_t sig[RSA_VERIFY_BATCH_CHUNK], res[RSA_VERIFY_BATCH_CHUNK];
+    const bigInt_t *sig_ptr[RSA_VERIFY_BATCH_CHUNK];
+    bigInt_t *res_ptr[RSA_VERIFY_BATCH_CHUNK];
+    const uint8_t *msg_ptr[RSA_VERIFY_BATCH_CHUNK];
+    size_t msg_len[RSA_VERIFY_BATCH_CHUNK];
+    uint8_t message_hash[RSA_VERIFY_BATCH_CHUNK][SHA256_DIGEST_SIZE];
+    uint8_t sig_hash[RSA_VERIFY_BATCH_CHUNK][RSA_MAX_DIGEST_SIZE];
+    rsa_hash_alg_t alg[RSA_VERIFY_BATCH_CHUNK];
+    rsa_verify_result_t overall = RSA_VERIFY_OK;
+
+    for (size_t start = 0; start < count; start += RSA_VERIFY_BATCH_CHUNK) {
+        size_t n = (count - start < RSA_VERIFY_BATCH_CHUNK) ? count - start : RSA_VERIFY_BATCH_CHUNK;
+
+        // Malformed items ride along as 0 and are reported as errors
+        for (size_t i = 0; i < n; i++) {
+            const rsa_verify_item_t *item = &items[start + i];
+            bigint_init(&sig[i], sig_words + i * stride, words);
+            bigint_init(&res[i], res_words + i * stride, words);
+            results[start + i] = RSA_VERIFY_OK;
+            if (!item->message || !item->signature || item->message_len == 0 ||
+                bigint_from_bytes(&sig[i], item->signature, mod_len) != BIGINT_OK) {
+                bigint_zero(&sig[i]);
+                results[start + i] = RSA_VERIFY_ERROR;
+            } else if (!rsa_signature_in_range(key, &sig[i])) {
+                bigint_zero(&sig[i]);
+                results[start + i] = RSA_VERIFY_INVALID_SIGNATURE;
+            }
+            sig_ptr[i] = &sig[i];
+            res_ptr[i] = &res[i];
+        }
+
+        if (bigint_mont_exp_uint_batch(res_ptr, sig_ptr, n, key->exponent, &key->mont) != BIGINT_OK) {
+            for (size_t i = 0; i < n; i++) results[start + i] = RSA_VERIFY_ERROR;
+        }
+
+        // Decode the padding first: it names the digest of each message
+        for (size_t i = 0; i < n; i++) {
+            if (results[start + i] == RSA_VERIFY_OK) {
+                const uint8_t *digest;
+                if (bigint_to_bytes(&res[i], decrypted, mod_len) != BIGINT_OK) {
+                    results[start + i] = RSA_VERIFY_ERROR;
+                } else {
+                    results[start + i] = rsa_check_pkcs1(decrypted, mod_len, &alg[i], &digest);
+                }
+                if (results[start + i] == RSA_VERIFY_OK) {
+                    memcpy(sig_hash[i], digest, rsa_digest_info[alg[i]].digest_len);
+                }
+            }
+        }
+
+        // The chunk's SHA-256 messages are hashed side by side as well
+        size_t hashed = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (results[start + i] == RSA_VERIFY_OK && alg[i] == RSA_HASH_SHA256) {
+                msg_ptr[hashed] = items[start + i].message;
+                msg_len[hashed] = items[start + i].message_len;
+                hashed++;
+            }
+        }
+        sha256_hash_many(msg_ptr, msg_len, message_hash, hashed);
+
+        hashed = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (results[start + i] == RSA_VERIFY_OK) {
+                uint8_t other_hash[RSA_MAX_DIGEST_SIZE];
+                const uint8_t *hash = other_hash;
+                if (alg[i] == RSA_HASH_SHA256) {
+                    hash = message_hash[hashed++];
+                } else {
+                    rsa_hash_message(alg[i], items[start + i].message, items[start + i].message_len, other_hash);
+                }
+                if (memcmp(sig_hash[i], hash, rsa_digest_info[alg[i]].digest_len) != 0) {
+                    results[start + i] = RSA_VERIFY_INVALID_SIGNATURE;
+                }
+            }
+            if (results[start + i] != RSA_VERIFY_OK && overall == RSA_VERIFY_OK) {
+                overall = results[start + i];
+            }
+        }
+    }
+    return overall;
+}
+
+// Checks the PKCS#1 v1.5 encoding of an RSA public-key result (mod_len bytes,
+// leading zeros kept) and finds its digest algorithm and the signed digest
+static rsa_verify_result_t rsa_check_pkcs1(
+    const uint8_t *decrypted, size_t mod_len,
+    rsa_hash_alg_t *alg, const uint8_t **digest
+) {
     // Check padding structure: 0x00 0x01 FF...FF 0x00 DigestInfo Hash
     if (decrypted[0] != 0x00 || decrypted[1] != 0x01) {
         return RSA_VERIFY_PADDING_ERROR;
@@ -62,39 +493,56 @@ rsa_verify_result_t rsa_verify_signature(
         return RSA_VERIFY_PADDING_ERROR;
     }
     
-    // Verify DigestInfo structure
+    // The DigestInfo fills the rest of the block; its length and prefix must
+    // match one of the supported digests exactly
     size_t digest_info_pos = separator_pos + 1;
-    size_t expected_digest_info_len = RSA_PKCS1_SHA256_PREFIX_LEN + SHA256_DIGEST_SIZE;
-    
-    if (digest_info_pos + expected_digest_info_len != mod_len) {
-        return RSA_VERIFY_PADDING_ERROR;
-    }
-    // Check DigestInfo prefix
-    if (memcmp(decrypted + digest_info_pos, RSA_PKCS1_SHA256_PREFIX, 
-               RSA_PKCS1_SHA256_PREFIX_LEN) != 0) {
-        return RSA_VERIFY_PADDING_ERROR;
+    size_t digest_info_len = mod_len - digest_info_pos;
+    for (size_t a = 0; a < RSA_HASH_ALG_COUNT; a++) {
+        size_t prefix_len = rsa_digest_info[a].prefix_len;
+        if (digest_info_len == prefix_len + rsa_digest_info[a].digest_len &&
+            memcmp(decrypted + digest_info_pos, rsa_digest_info[a].prefix, prefix_len) == 0) {
+            *alg = (rsa_hash_alg_t)a;
+            *digest = decrypted + digest_info_pos + prefix_len;
+            return RSA_VERIFY_OK;
+        }
     }
-    
-    // Extract hash from decrypted signature
-    uint8_t *sig_hash = decrypted + digest_info_pos + RSA_PKCS1_SHA256_PREFIX_LEN;
+    return RSA_VERIFY_PADDING_ERROR;
+}
 
-    // Compute hash of message
-    uint8_t message_hash[SHA256_DIGEST_SIZE];
-    sha256_hash(message, message_len, message_hash);
-    
-    // Compare hashes
-    if (memcmp(sig_hash, message_hash, SHA256_DIGEST_SIZE) == 0) {
-        return RSA_VERIFY_OK;
-    } else {
-        return RSA_VERIFY_INVALID_SIGNATURE;
+// The embedded key, parsed once by whichever thread gets here first
+static rsa_public_key_t firmware_key;
+static bool firmware_key_valid;
+#if RSA_THREAD_SAFE
+static pthread_once_t firmware_key_once = PTHREAD_ONCE_INIT;
+#else
+static bool firmware_key_done;
+#endif
+
+static void firmware_key_init(void) {
+    firmware_key_valid =
+        rsa_public_key_init(&firmware_key, rsa_modulus, RSA_KEY_SIZE, rsa_exponent) == RSA_VERIFY_OK;
+}
+
+const rsa_public_key_t *firmware_public_key(void) {
+#if RSA_THREAD_SAFE
+    pthread_once(&firmware_key_once, firmware_key_init);
+#else
+    if (!firmware_key_done) {
+        firmware_key_init();
+        firmware_key_done = true;
     }
+#endif
+    return firmware_key_valid ? &firmware_key : NULL;
 }
 
 rsa_verify_result_t verify_firmware(const uint8_t *firmware_data, size_t firmware_size) {
-    return rsa_verify_signature(
+    const rsa_public_key_t *key = firmware_public_key();
+    if (!key) {
+        return RSA_VERIFY_ERROR;
+    }
+    return rsa_verify_with_key(
+        key,
         firmware_data, firmware_size,
-        firmware_signature, SIGNATURE_SIZE,
-        rsa_modulus, RSA_KEY_SIZE,
-        rsa_exponent
+        firmware_signature, SIGNATURE_SIZE
     );
-}
\ No newline at end of file
+}
@@ -3,6 +3,7 @@
 
 #include "bigint.h"
 #include "sha256.h"
+#include "sha512.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -14,22 +15,270 @@ static const uint8_t RSA_PKCS1_SHA256_PREFIX[RSA_PKCS1_SHA256_PREFIX_LEN] = {
     0x00, 0x04, 0x20
 };
 
+// DigestInfo prefixes for SHA-384 and SHA-512 (RFC 8017, section 9.2), same length
+#define RSA_PKCS1_SHA384_PREFIX_LEN 19
+static const uint8_t RSA_PKCS1_SHA384_PREFIX[RSA_PKCS1_SHA384_PREFIX_LEN] = {
+    0x30, 0x41, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86,
+    0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x02, 0x05,
+    0x00, 0x04, 0x30
+};
+#define RSA_PKCS1_SHA512_PREFIX_LEN 19
+static const uint8_t RSA_PKCS1_SHA512_PREFIX[RSA_PKCS1_SHA512_PREFIX_LEN] = {
+    0x30, 0x51, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86,
+    0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x03, 0x05,
+    0x00, 0x04, 0x40
+};
+
+// Largest modulus accepted by rsa_verify_signature (2048, 3072 and 4096-bit
+// keys with the default -DBIGINT_MAX_MOD_BITS=4096)
+#define RSA_MAX_MODULUS_BYTES (BIGINT_MAX_MOD_BITS / 8)
+
+// Smallest modulus a PKCS#1 v1.5 signature fits in: 0x00 0x01, eight 0xFF
+// padding bytes, 0x00 and the shortest DigestInfo (SHA-256)
+#define RSA_MIN_MODULUS_BYTES (11 + RSA_PKCS1_SHA256_PREFIX_LEN + SHA256_DIGEST_SIZE)
+
 typedef enum {
     RSA_VERIFY_OK = 0,
     RSA_VERIFY_ERROR = -1,
     RSA_VERIFY_INVALID_SIGNATURE = -2,
-    RSA_VERIFY_PADDING_ERROR = -3
+    RSA_VERIFY_PADDING_ERROR = -3,
+    RSA_VERIFY_UNKNOWN_KEY = -4,    // key ID not in the keyring (rsa_keyring.h)
+    RSA_VERIFY_MANIFEST_MISMATCH = -5   // data does not match a signed manifest (rsa_manifest.h)
 } rsa_verify_result_t;
 
+// Message digest of a signature, read from its DigestInfo
+typedef enum {
+    RSA_HASH_SHA256 = 0,
+    RSA_HASH_SHA384 = 1,
+    RSA_HASH_SHA512 = 2
+} rsa_hash_alg_t;
+
+#define RSA_MAX_DIGEST_SIZE SHA512_DIGEST_SIZE
+
+// RSA public key parsed once for any number of verifications: the modulus in
+// limb form with its Montgomery constants, its size and the public exponent
+typedef struct {
+    bigIntMontCtx_t mont;   // modulus limbs, R^2 mod n, -n^-1 and the vector kernel state
+    size_t mod_len;         // modulus (and signature) length in bytes
+    uint32_t bits;          // modulus bit length
+    uint32_t exponent;      // public exponent
+} rsa_public_key_t;
+
+/**
+ * Build a public key context for rsa_verify_with_key
+ * 
+ * @param key: Context to fill
+ * @param modulus: RSA public key modulus (big-endian bytes, odd)
+ * @param mod_len: Modulus length in bytes (at most RSA_MAX_MODULUS_BYTES)
+ * @param exponent: RSA public exponent (typically 65537)
+ * @return RSA_VERIFY_OK on success, RSA_VERIFY_ERROR for an unusable modulus
+ *         (even, or shorter than RSA_MIN_MODULUS_BYTES without its leading zeros)
+ */
+rsa_verify_result_t rsa_public_key_init(
+    rsa_public_key_t *key,
+    const uint8_t *modulus, size_t mod_len,
+    uint32_t exponent
+);
+
+// Scratch for rsa_verify_with_key_ws with a modulus of mod_len bytes: the
+// bigint exponentiation scratch, signature and result operands and the decoded
+// block, RSA_WORKSPACE_ALIGN-byte aligned. RSA_VERIFY_WORKSPACE_MAX fits any
+// supported key. With the workspace, one verification stays under 2 KB of
+// stack on x86-64 (see README, "Stack usage").
+#define RSA_WORKSPACE_ALIGN BIGINT_SCRATCH_ALIGN
+#define RSA_MODULUS_WORDS(mod_len) BIGINT_WORDS_FOR_BITS(8 * (size_t)(mod_len))
+#define RSA_VERIFY_WORKSPACE_SIZE(mod_len) \
+    (BIGINT_WORD_BYTES * (BIGINT_MONT_EXP_UINT_SCRATCH(RSA_MODULUS_WORDS(mod_len)) + \
+                          2 * BIGINT_SCRATCH_ROUND(RSA_MODULUS_WORDS(mod_len))) + (size_t)(mod_len))
+#define RSA_VERIFY_WORKSPACE_MAX RSA_VERIFY_WORKSPACE_SIZE(RSA_MAX_MODULUS_BYTES)
+
+/**
+ * Verify RSA signature using PKCS#1 v1.5 padding against a prepared public
+ * key. The message digest (SHA-256, SHA-384 or SHA-512) is the one named in
+ * the signature's DigestInfo.
+ * 
+ * @param key: Public key built by rsa_public_key_init
+ * @param message: Message data to verify
+ * @param message_len: Length of message
+ * @param signature: RSA signature bytes (big-endian)
+ * @param sig_len: Signature length (should be key->mod_len)
+ * @return RSA_VERIFY_OK if signature is valid, error code otherwise
+ */
+rsa_verify_result_t rsa_verify_with_key(
+    const rsa_public_key_t *key,
+    const uint8_t *message, size_t message_len,
+    const uint8_t *signature, size_t sig_len
+);
+
+/**
+ * Workspace size rsa_verify_with_key_ws needs for a key
+ * 
+ * @param key: Public key built by rsa_public_key_init
+ * @return Size in bytes (RSA_VERIFY_WORKSPACE_SIZE(key->mod_len))
+ */
+size_t rsa_verify_workspace_size(const rsa_public_key_t *key);
+
+/**
+ * rsa_verify_with_key with all large temporaries in a caller-supplied
+ * workspace instead of on the stack
+ * 
+ * @param key: Public key built by rsa_public_key_init
+ * @param message: Message data to verify
+ * @param message_len: Length of message
+ * @param signature: RSA signature bytes (big-endian)
+ * @param sig_len: Signature length (should be key->mod_len)
+ * @param workspace: Scratch memory, RSA_WORKSPACE_ALIGN-byte aligned
+ * @param workspace_size: At least rsa_verify_workspace_size(key) bytes
+ * @return RSA_VERIFY_OK if signature is valid, error code otherwise
+ */
+rsa_verify_result_t rsa_verify_with_key_ws(
+    const rsa_public_key_t *key,
+    const uint8_t *message, size_t message_len,
+    const uint8_t *signature, size_t sig_len,
+    void *workspace, size_t workspace_size
+);
+
+/**
+ * Find which digest a signature was made with, before hashing the message
+ * (for rsa_verify_init_hash). Runs the RSA operation and checks the padding.
+ * 
+ * @param key: Public key built by rsa_public_key_init
+ * @param signature: RSA signature bytes (big-endian)
+ * @param sig_len: Signature length (should be key->mod_len)
+ * @param alg: Receives the digest algorithm
+ * @param digest: Receives the signed digest, for rsa_verify_final_expected
+ *                (may be NULL)
+ * @return RSA_VERIFY_OK on success, error code otherwise (as rsa_verify_with_key)
+ */
+rsa_verify_result_t rsa_signature_hash_alg(
+    const rsa_public_key_t *key,
+    const uint8_t *signature, size_t sig_len,
+    rsa_hash_alg_t *alg,
+    uint8_t digest[RSA_MAX_DIGEST_SIZE]
+);
+
+// Streaming verification: the message is hashed as it is fed in, so it never
+// has to be in memory at once
+typedef struct {
+    const rsa_public_key_t *key;    // must stay valid until rsa_verify_final
+    rsa_hash_alg_t alg;
+    union {
+        sha256_ctx_t sha;           // RSA_HASH_SHA256
+        sha512_ctx_t sha512;        // RSA_HASH_SHA384, RSA_HASH_SHA512
+    };
+} rsa_verify_ctx_t;
+
+/**
+ * Start a streaming verification of a SHA-256 signature
+ * 
+ * @param ctx: Context to initialize
+ * @param key: Public key built by rsa_public_key_init
+ * @return RSA_VERIFY_OK on success, RSA_VERIFY_ERROR on bad arguments
+ */
+rsa_verify_result_t rsa_verify_init(rsa_verify_ctx_t *ctx, const rsa_public_key_t *key);
+
+/**
+ * Start a streaming verification with the given digest
+ * 
+ * @param ctx: Context to initialize
+ * @param key: Public key built by rsa_public_key_init
+ * @param alg: Digest of the signature (see rsa_signature_hash_alg)
+ * @return RSA_VERIFY_OK on success, RSA_VERIFY_ERROR on bad arguments
+ */
+rsa_verify_result_t rsa_verify_init_hash(rsa_verify_ctx_t *ctx, const rsa_public_key_t *key, rsa_hash_alg_t alg);
+
+/**
+ * Feed the next part of the message
+ * 
+ * @param ctx: Context from rsa_verify_init
+ * @param data: Message bytes
+ * @param len: Number of bytes (any size, including 0)
+ */
+void rsa_verify_update(rsa_verify_ctx_t *ctx, const uint8_t *data, size_t len);
+
+/**
+ * Save the hashing progress of a streaming verification, so a later run can
+ * continue with rsa_verify_resume after appending data or resuming a download
+ * 
+ * @param ctx: Context from rsa_verify_init or rsa_verify_resume, not finished yet
+ * @param checkpoint: Receives the checkpoint (sha256_export format)
+ * @return RSA_VERIFY_OK on success, RSA_VERIFY_ERROR on bad arguments or a
+ *         context that is not hashing with SHA-256
+ */
+rsa_verify_result_t rsa_verify_checkpoint(const rsa_verify_ctx_t *ctx, uint8_t checkpoint[SHA256_CHECKPOINT_SIZE]);
+
+/**
+ * Start a streaming verification from a checkpoint instead of byte 0: only the
+ * message bytes from *offset on are then fed with rsa_verify_update. The
+ * checkpoint is trusted as is, so it must come from the same prefix of the data.
+ * 
+ * @param ctx: Context to initialize
+ * @param key: Public key built by rsa_public_key_init
+ * @param checkpoint: Checkpoint from rsa_verify_checkpoint
+ * @param offset: Receives the number of message bytes the checkpoint covers (may be NULL)
+ * @return RSA_VERIFY_OK on success, RSA_VERIFY_ERROR on bad arguments or an invalid checkpoint
+ */
+rsa_verify_result_t rsa_verify_resume(
+    rsa_verify_ctx_t *ctx, const rsa_public_key_t *key,
+    const uint8_t checkpoint[SHA256_CHECKPOINT_SIZE], uint64_t *offset
+);
+
+/**
+ * Finish a streaming verification; the context needs rsa_verify_init again
+ * before reuse
+ * 
+ * @param ctx: Context fed with the whole message
+ * @param signature: RSA signature bytes (big-endian)
+ * @param sig_len: Signature length (should be key->mod_len)
+ * @return RSA_VERIFY_OK if signature is valid, error code otherwise (also for
+ *         an empty message, as in rsa_verify_with_key, and for a signature
+ *         made with another digest than the context's)
+ */
+rsa_verify_result_t rsa_verify_final(rsa_verify_ctx_t *ctx, const uint8_t *signature, size_t sig_len);
+
+/**
+ * rsa_verify_final that also hands back the message digest
+ * 
+ * @param ctx: Context fed with the whole message
+ * @param signature: RSA signature bytes (big-endian)
+ * @param sig_len: Signature length (should be key->mod_len)
+ * @param digest: Receives the digest of ctx->alg (whenever the message was
+ *                hashed, whatever the signature check gives)
+ * @return Same as rsa_verify_final
+ */
+rsa_verify_result_t rsa_verify_final_digest(
+    rsa_verify_ctx_t *ctx,
+    const uint8_t *signature, size_t sig_len,
+    uint8_t digest[RSA_MAX_DIGEST_SIZE]
+);
+
+/**
+ * rsa_verify_final_digest for a signature already decoded by
+ * rsa_signature_hash_alg: the message digest is compared with the signed one,
+ * without running the RSA operation again
+ * 
+ * @param ctx: Context fed with the whole message, started with the
+ *             algorithm rsa_signature_hash_alg found
+ * @param expected: Signed digest from rsa_signature_hash_alg
+ * @param digest: Receives the digest of ctx->alg (as rsa_verify_final_digest)
+ * @return Same as rsa_verify_final
+ */
+rsa_verify_result_t rsa_verify_final_expected(
+    rsa_verify_ctx_t *ctx,
+    const uint8_t expected[RSA_MAX_DIGEST_SIZE],
+    uint8_t digest[RSA_MAX_DIGEST_SIZE]
+);
+
 /**
- * Verify RSA signature using PKCS#1 v1.5 padding with SHA-256
+ * Verify RSA signature using PKCS#1 v1.5 padding with SHA-256, SHA-384 or
+ * SHA-512, as named in the signature's DigestInfo
  * 
  * @param message: Message data to verify
  * @param message_len: Length of message
  * @param signature: RSA signature bytes (big-endian)
  * @param sig_len: Signature length (should be same as modulus size)
  * @param modulus: RSA public key modulus (big-endian bytes)
- * @param mod_len: Modulus length in bytes
+ * @param mod_len: Modulus length in bytes (at most RSA_MAX_MODULUS_BYTES)
  * @param exponent: RSA public exponent (typically 65537)
  * @return RSA_VERIFY_OK if signature is valid, error code otherwise
  */
@@ -39,5 +288,86 @@ rsa_verify_result_t rsa_verify_signature(
     const uint8_t *modulus, size_t mod_len,
     uint32_t exponent
 );
+
+// One (message, signature) pair of a batch verification
+typedef struct {
+    const uint8_t *message;
+    size_t message_len;
+    const uint8_t *signature;   // mod_len bytes, big-endian
+} rsa_verify_item_t;
+
+/**
+ * Verify a batch of RSA signatures made with the same public key (PKCS#1 v1.5, SHA-256/384/512).
+ * Same result per item as rsa_verify_signature, at a higher throughput.
+ * 
+ * @param items: Signatures and messages to check
+ * @param results: Receives one result per item
+ * @param count: Number of items
+ * @param modulus: RSA public key modulus (big-endian bytes)
+ * @param mod_len: Modulus length in bytes (at most RSA_MAX_MODULUS_BYTES), also the signature length
+ * @param exponent: RSA public exponent (typically 65537)
+ * @return RSA_VERIFY_OK if every signature is valid, otherwise the first failing item's result
+ */
+rsa_verify_result_t rsa_verify_signature_batch(
+    const rsa_verify_item_t *items, rsa_verify_result_t *results, size_t count,
+    const uint8_t *modulus, size_t mod_len,
+    uint32_t exponent
+);
+
+/**
+ * rsa_verify_signature_batch against a prepared public key
+ * 
+ * @param key: Public key built by rsa_public_key_init
+ * @param items: Signatures (key->mod_len bytes each) and messages to check
+ * @param results: Receives one result per item
+ * @param count: Number of items
+ * @return RSA_VERIFY_OK if every signature is valid, otherwise the first failing item's result
+ */
+rsa_verify_result_t rsa_verify_batch_with_key(
+    const rsa_public_key_t *key,
+    const rsa_verify_item_t *items, rsa_verify_result_t *results, size_t count
+);
+
+// Signatures handed to the bigint batch at once (two full IFMA lane groups)
+#define RSA_VERIFY_BATCH_CHUNK (2 * BIGINT_BATCH_MAX_LANES)
+
+// Scratch for rsa_verify_batch_with_key_ws with a modulus of mod_len bytes:
+// the signature and result operands of one chunk and the decoded block,
+// RSA_WORKSPACE_ALIGN-byte aligned. RSA_VERIFY_BATCH_WORKSPACE_MAX fits any
+// supported key.
+#define RSA_VERIFY_BATCH_WORKSPACE_SIZE(mod_len) \
+    (BIGINT_WORD_BYTES * 2 * RSA_VERIFY_BATCH_CHUNK * BIGINT_SCRATCH_ROUND(RSA_MODULUS_WORDS(mod_len)) + \
+     (size_t)(mod_len))
+#define RSA_VERIFY_BATCH_WORKSPACE_MAX RSA_VERIFY_BATCH_WORKSPACE_SIZE(RSA_MAX_MODULUS_BYTES)
+
+/**
+ * rsa_verify_batch_with_key with the signature and result operands in a
+ * caller-supplied workspace instead of on the stack
+ * 
+ * @param key: Public key built by rsa_public_key_init
+ * @param items: Signatures (key->mod_len bytes each) and messages to check
+ * @param results: Receives one result per item
+ * @param count: Number of items
+ * @param workspace: Scratch memory, RSA_WORKSPACE_ALIGN-byte aligned
+ * @param workspace_size: At least RSA_VERIFY_BATCH_WORKSPACE_SIZE(key->mod_len) bytes
+ * @return RSA_VERIFY_OK if every signature is valid, otherwise the first failing
+ *         item's result (RSA_VERIFY_ERROR for every item if the workspace is unusable)
+ */
+rsa_verify_result_t rsa_verify_batch_with_key_ws(
+    const rsa_public_key_t *key,
+    const rsa_verify_item_t *items, rsa_verify_result_t *results, size_t count,
+    void *workspace, size_t workspace_size
+);
+
+/**
+ * The embedded key (rsa_keys.h), prepared on first use and shared by all
+ * callers, as verify_firmware uses it. Thread-safe unless built with
+ * -DRSA_THREAD_SAFE=0.
+ *
+ * @return The key, NULL if the embedded modulus is unusable
+ */
+const rsa_public_key_t *firmware_public_key(void);
+
 rsa_verify_result_t verify_firmware(const uint8_t *firmware_data, size_t firmware_size);
+
 #endif // RSA_VERIFY_H
\ No newline at end of file
@@ -0,0 +1,241 @@
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+#include "rsa_cache.h"
+
+#if defined(__APPLE__)
+#define RSA_CACHE_MTIME(st) ((st)->st_mtimespec)
+#define RSA_CACHE_CTIME(st) ((st)->st_ctimespec)
+#else
+#define RSA_CACHE_MTIME(st) ((st)->st_mtim)
+#define RSA_CACHE_CTIME(st) ((st)->st_ctim)
+#endif
+
+// Stored as is (host layout); zeroed before filling so padding is deterministic
+struct rsa_cache_entry {
+    // File identity
+    uint64_t dev, ino, size;
+    int64_t mtime_sec, ctime_sec;
+    uint32_t mtime_nsec, ctime_nsec;
+    // Signer and signature
+    uint8_t key_id[RSA_KEY_ID_SIZE];
+    uint32_t exponent;
+    uint8_t sig_hash[SHA256_DIGEST_SIZE];
+    // Outcome
+    int32_t alg;
+    int32_t verdict;
+    uint8_t digest[RSA_MAX_DIGEST_SIZE];
+};
+
+// Cache file header, followed by count entries
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t entry_size;
+    uint32_t count;
+} rsa_cache_header_t;
+
+// Key ID, exponent and signature hash of an entry
+static void rsa_cache_subject(rsa_cache_entry_t *e, const rsa_public_key_t *key,
+                              const uint8_t *signature, size_t sig_len) {
+    uint8_t modulus[RSA_MAX_MODULUS_BYTES];
+    bigInt_t n = { (bigIntWord_t *)key->mont.n, key->mont.length, BIGINT_MAX_MOD_WORDS };
+    bigint_to_bytes(&n, modulus, key->mod_len);
+    rsa_key_id(modulus, key->mod_len, e->key_id);
+    e->exponent = key->exponent;
+    sha256_hash(signature, sig_len, e->sig_hash);
+}
+
+static bool rsa_cache_same_subject(const rsa_cache_entry_t *a, const rsa_cache_entry_t *b) {
+    return a->dev == b->dev && a->ino == b->ino && a->exponent == b->exponent &&
+           memcmp(a->key_id, b->key_id, RSA_KEY_ID_SIZE) == 0 &&
+           memcmp(a->sig_hash, b->sig_hash, SHA256_DIGEST_SIZE) == 0;
+}
+
+static bool rsa_cache_same_identity(const rsa_cache_entry_t *a, const rsa_cache_entry_t *b) {
+    return a->dev == b->dev && a->ino == b->ino && a->size == b->size &&
+           a->mtime_sec == b->mtime_sec && a->mtime_nsec == b->mtime_nsec &&
+           a->ctime_sec == b->ctime_sec && a->ctime_nsec == b->ctime_nsec;
+}
+
+#ifndef _WIN32
+static bool rsa_cache_identity(const char *path, rsa_cache_entry_t *e) {
+    struct stat st;
+    if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) return false;
+    e->dev = (uint64_t)st.st_dev;
+    e->ino = (uint64_t)st.st_ino;
+    e->size = (uint64_t)st.st_size;
+    e->mtime_sec = (int64_t)RSA_CACHE_MTIME(&st).tv_sec;
+    e->mtime_nsec = (uint32_t)RSA_CACHE_MTIME(&st).tv_nsec;
+    e->ctime_sec = (int64_t)RSA_CACHE_CTIME(&st).tv_sec;
+    e->ctime_nsec = (uint32_t)RSA_CACHE_CTIME(&st).tv_nsec;
+    return true;
+}
+
+// Reads the cache file; anything unexpected leaves the cache empty
+static void rsa_cache_load(rsa_verify_cache_t *cache) {
+    int fd = open(cache->path, O_RDONLY | O_NOFOLLOW);
+    if (fd < 0) return;
+    struct stat st;
+    rsa_cache_header_t header;
+    // Only trust a file nobody else could have written
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_uid == geteuid() &&
+        !(st.st_mode & (S_IWGRP | S_IWOTH)) &&
+        read(fd, &header, sizeof(header)) == (ssize_t)sizeof(header) &&
+        memcmp(header.magic, RSA_CACHE_MAGIC, 4) == 0 && header.version == RSA_CACHE_VERSION &&
+        header.entry_size == sizeof(rsa_cache_entry_t) && header.count <= RSA_CACHE_MAX_ENTRIES &&
+        (uint64_t)st.st_size == sizeof(header) + (uint64_t)header.count * sizeof(rsa_cache_entry_t)) {
+        size_t len = header.count * sizeof(rsa_cache_entry_t);
+        if (read(fd, cache->entries, len) == (ssize_t)len) {
+            cache->count = header.count;
+        }
+    }
+    close(fd);
+}
+
+// Replaces the cache file with the current entries (best effort)
+static void rsa_cache_save(const rsa_verify_cache_t *cache) {
+    size_t tmp_len = strlen(cache->path) + 32;
+    char *tmp = malloc(tmp_len);
+    if (!tmp) return;
+    snprintf(tmp, tmp_len, "%s.%ld.tmp", cache->path, (long)getpid());
+
+    rsa_cache_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RSA_CACHE_MAGIC, 4);
+    header.version = RSA_CACHE_VERSION;
+    header.entry_size = sizeof(rsa_cache_entry_t);
+    header.count = (uint32_t)cache->count;
+    size_t len = cache->count * sizeof(rsa_cache_entry_t);
+
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW, 0600);
+    bool ok = fd >= 0 &&
+              write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header) &&
+              write(fd, cache->entries, len) == (ssize_t)len &&
+              fsync(fd) == 0;
+    if (fd >= 0) ok = (close(fd) == 0) && ok;
+    // rename is atomic: readers see the old or the new file, never a mix
+    if (!ok || rename(tmp, cache->path) != 0) unlink(tmp);
+    free(tmp);
+}
+#endif
+
+rsa_verify_result_t rsa_verify_cache_open(rsa_verify_cache_t *cache, const char *path) {
+    if (!cache) return RSA_VERIFY_ERROR;
+    memset(cache, 0, sizeof(*cache));
+#ifdef _WIN32
+    (void)path;
+    return RSA_VERIFY_ERROR;
+#else
+    if (!path) return RSA_VERIFY_ERROR;
+    cache->path = malloc(strlen(path) + 1);
+    cache->entries = calloc(RSA_CACHE_MAX_ENTRIES, sizeof(rsa_cache_entry_t));
+    if (!cache->path || !cache->entries || pthread_mutex_init(&cache->lock, NULL) != 0) {
+        free(cache->path);
+        free(cache->entries);
+        cache->entries = NULL;
+        return RSA_VERIFY_ERROR;
+    }
+    strcpy(cache->path, path);
+    rsa_cache_load(cache);
+    return RSA_VERIFY_OK;
+#endif
+}
+
+void rsa_verify_cache_close(rsa_verify_cache_t *cache) {
+    if (!cache || !cache->entries) return;
+    pthread_mutex_destroy(&cache->lock);
+    free(cache->entries);
+    free(cache->path);
+    cache->entries = NULL;
+    cache->path = NULL;
+    cache->count = 0;
+}
+
+rsa_verify_result_t rsa_verify_file_cached(
+    rsa_verify_cache_t *cache, const char *path,
+    const rsa_public_key_t *key,
+    const uint8_t *signature, size_t sig_len,
+    rsa_file_io_t mode, unsigned flags, rsa_file_stats_t *stats
+) {
+#ifndef _WIN32
+    rsa_cache_entry_t probe, after;
+    if (cache && cache->entries && path && key && signature && sig_len == key->mod_len) {
+        memset(&probe, 0, sizeof(probe));
+        memset(&after, 0, sizeof(after));
+        rsa_cache_subject(&probe, key, signature, sig_len);
+        bool known = rsa_cache_identity(path, &probe);
+
+        if (known && !(flags & RSA_CACHE_REHASH)) {
+            bool hit = false;
+            pthread_mutex_lock(&cache->lock);
+            for (size_t i = 0; i < cache->count && !hit; i++) {
+                const rsa_cache_entry_t *e = &cache->entries[i];
+                if (rsa_cache_same_subject(e, &probe) && rsa_cache_same_identity(e, &probe)) {
+                    probe.alg = e->alg;
+                    probe.verdict = e->verdict;
+                    memcpy(probe.digest, e->digest, RSA_MAX_DIGEST_SIZE);
+                    hit = true;
+                }
+            }
+            pthread_mutex_unlock(&cache->lock);
+            if (hit) {
+                if (stats) {
+                    memset(stats, 0, sizeof(*stats));
+                    stats->alg = (rsa_hash_alg_t)probe.alg;
+                    memcpy(stats->digest, probe.digest, RSA_MAX_DIGEST_SIZE);
+                    stats->cache_hit = true;
+                }
+                return (rsa_verify_result_t)probe.verdict;
+            }
+        }
+
+        time_t start = time(NULL);
+        rsa_file_stats_t local;
+        memset(&local, 0, sizeof(local));
+        rsa_verify_result_t result = rsa_verify_file(path, key, signature, sig_len, mode, &local);
+        if (stats) *stats = local;
+
+        // Keep only verdicts on a file that was hashed whole, did not change
+        // meanwhile, and was last written well before the hashing started. A
+        // signature rejected before the file was read (bytes 0) has no digest
+        // to keep, and is cheap to reject again.
+        after = probe;
+        if (known && result != RSA_VERIFY_ERROR && local.bytes > 0 &&
+            rsa_cache_identity(path, &after) && rsa_cache_same_identity(&probe, &after) &&
+            probe.mtime_sec + RSA_CACHE_RACY_SECONDS <= (int64_t)start &&
+            probe.ctime_sec + RSA_CACHE_RACY_SECONDS <= (int64_t)start) {
+            probe.alg = (int32_t)local.alg;
+            probe.verdict = (int32_t)result;
+            memcpy(probe.digest, local.digest, RSA_MAX_DIGEST_SIZE);
+
+            pthread_mutex_lock(&cache->lock);
+            size_t kept = 0;
+            for (size_t i = 0; i < cache->count; i++) {
+                if (!rsa_cache_same_subject(&cache->entries[i], &probe)) {
+                    cache->entries[kept++] = cache->entries[i];
+                }
+            }
+            if (kept == RSA_CACHE_MAX_ENTRIES) {
+                memmove(cache->entries, cache->entries + 1, (kept - 1) * sizeof(rsa_cache_entry_t));
+                kept--;
+            }
+            cache->entries[kept] = probe;
+            cache->count = kept + 1;
+            rsa_cache_save(cache);
+            pthread_mutex_unlock(&cache->lock);
+        }
+        return result;
+    }
+#endif
+    (void)cache;
+    (void)flags;
+    return rsa_verify_file(path, key, signature, sig_len, mode, stats);
+}
@@ -0,0 +1,86 @@
+#ifndef RSA_CACHE_H
+#define RSA_CACHE_H
+
+#include "rsa2048.h"
+#include "rsa_file.h"
+#include "rsa_keyring.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * On-disk cache of rsa_verify_file results. An entry is keyed by the file's
+ * identity (device, inode, size, modification and status-change times), the
+ * key ID and exponent, and the SHA-256 of the signature; it holds the file
+ * digest and the verdict. Any change to the file, the key or the signature
+ * therefore misses, and the file is verified again.
+ *
+ * Entries are only stored when the file's identity did not change while it
+ * was hashed and its timestamps are at least RSA_CACHE_RACY_SECONDS old, so
+ * a write within the timestamp granularity cannot hide behind an unchanged
+ * identity. Read errors are never cached.
+ *
+ * The cache file says which images are trusted: keep it where only the
+ * verifying user can write (it is created with mode 0600, and one writable
+ * by group or others, or owned by another user, is ignored). The format is
+ * host-specific. POSIX only; on Windows rsa_verify_cache_open fails and
+ * rsa_verify_file_cached always verifies.
+ */
+#define RSA_CACHE_MAGIC          "RVC1"
+#define RSA_CACHE_VERSION        1
+#define RSA_CACHE_MAX_ENTRIES    256     // the oldest entry goes when full
+#define RSA_CACHE_RACY_SECONDS   2
+
+// rsa_verify_file_cached flags
+#define RSA_CACHE_REHASH 0x1u   // always hash and verify again, then refresh the entry
+
+typedef struct rsa_cache_entry rsa_cache_entry_t;
+
+typedef struct {
+    char *path;                     // cache file
+    rsa_cache_entry_t *entries;     // oldest first
+    size_t count;
+    pthread_mutex_t lock;
+} rsa_verify_cache_t;
+
+/**
+ * Open a verification cache, loading the entries of the cache file if it
+ * exists (a missing, foreign or damaged file gives an empty cache)
+ *
+ * @param cache: Cache to initialize
+ * @param path: Cache file, written back on every new entry
+ * @return RSA_VERIFY_OK on success, RSA_VERIFY_ERROR otherwise
+ */
+rsa_verify_result_t rsa_verify_cache_open(rsa_verify_cache_t *cache, const char *path);
+
+/**
+ * Release a cache (the file keeps its entries)
+ *
+ * @param cache: Cache from rsa_verify_cache_open
+ */
+void rsa_verify_cache_close(rsa_verify_cache_t *cache);
+
+/**
+ * rsa_verify_file answered from the cache when the file, key and signature
+ * are unchanged since an earlier verification
+ *
+ * @param cache: Cache from rsa_verify_cache_open (NULL: plain rsa_verify_file)
+ * @param path: File to verify
+ * @param key: Public key built by rsa_public_key_init
+ * @param signature: RSA signature bytes (big-endian)
+ * @param sig_len: Signature length (should be key->mod_len)
+ * @param mode: I/O mode when the file has to be read
+ * @param flags: 0 or RSA_CACHE_REHASH
+ * @param stats: Receives the digest, whether the cache answered, and the
+ *               throughput when the file was read (may be NULL)
+ * @return Same as rsa_verify_file
+ */
+rsa_verify_result_t rsa_verify_file_cached(
+    rsa_verify_cache_t *cache, const char *path,
+    const rsa_public_key_t *key,
+    const uint8_t *signature, size_t sig_len,
+    rsa_file_io_t mode, unsigned flags, rsa_file_stats_t *stats
+);
+
+#endif // RSA_CACHE_H
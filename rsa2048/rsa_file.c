@@ -0,0 +1,181 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "rsa_file.h"
+
+// State shared by rsa_verify_file's reader thread and the hashing thread.
+// Buffer i is owned by the reader while !full[i] and by the hasher while full[i].
+typedef struct {
+    FILE *f;
+    uint8_t *buf[2];
+    size_t len[2];
+    bool full[2];
+    bool error;                 // the read failed (set with the last buffer)
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} rsa_file_reader_t;
+
+static double rsa_file_now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Fills the buffers in turn until a short read (end of file or error)
+static void *rsa_file_reader(void *arg) {
+    rsa_file_reader_t *r = (rsa_file_reader_t *)arg;
+    for (int i = 0;; i ^= 1) {
+        pthread_mutex_lock(&r->lock);
+        while (r->full[i]) pthread_cond_wait(&r->cond, &r->lock);
+        pthread_mutex_unlock(&r->lock);
+
+        size_t n = fread(r->buf[i], 1, RSA_FILE_CHUNK_SIZE, r->f);
+
+        pthread_mutex_lock(&r->lock);
+        r->len[i] = n;
+        r->full[i] = true;
+        if (n < RSA_FILE_CHUNK_SIZE) r->error = ferror(r->f) != 0;
+        pthread_cond_signal(&r->cond);
+        pthread_mutex_unlock(&r->lock);
+        if (n < RSA_FILE_CHUNK_SIZE) break;
+    }
+    return NULL;
+}
+
+// Hashes the file with reads overlapped; without a thread, one read after the other
+static rsa_verify_result_t rsa_file_hash_threaded(const char *path, rsa_verify_ctx_t *ctx, uint64_t *bytes) {
+    rsa_file_reader_t r;
+    r.f = fopen(path, "rb");
+    if (!r.f) return RSA_VERIFY_ERROR;
+    setvbuf(r.f, NULL, _IONBF, 0);      // fread straight into our buffers
+#if !defined(_WIN32) && defined(POSIX_FADV_SEQUENTIAL)
+    posix_fadvise(fileno(r.f), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    r.buf[0] = malloc(2 * (size_t)RSA_FILE_CHUNK_SIZE);
+    if (!r.buf[0]) {
+        fclose(r.f);
+        return RSA_VERIFY_ERROR;
+    }
+    r.buf[1] = r.buf[0] + RSA_FILE_CHUNK_SIZE;
+    r.full[0] = r.full[1] = false;
+    r.error = false;
+    pthread_mutex_init(&r.lock, NULL);
+    pthread_cond_init(&r.cond, NULL);
+
+    *bytes = 0;
+    pthread_t tid;
+    if (pthread_create(&tid, NULL, rsa_file_reader, &r) == 0) {
+        for (int i = 0;; i ^= 1) {
+            pthread_mutex_lock(&r.lock);
+            while (!r.full[i]) pthread_cond_wait(&r.cond, &r.lock);
+            size_t n = r.len[i];
+            pthread_mutex_unlock(&r.lock);
+
+            rsa_verify_update(ctx, r.buf[i], n);
+            *bytes += n;
+
+            pthread_mutex_lock(&r.lock);
+            r.full[i] = false;
+            pthread_cond_signal(&r.cond);
+            pthread_mutex_unlock(&r.lock);
+            if (n < RSA_FILE_CHUNK_SIZE) break;
+        }
+        pthread_join(tid, NULL);
+    } else {
+        size_t n;
+        while ((n = fread(r.buf[0], 1, RSA_FILE_CHUNK_SIZE, r.f)) > 0) {
+            rsa_verify_update(ctx, r.buf[0], n);
+            *bytes += n;
+        }
+        r.error = ferror(r.f) != 0;
+    }
+
+    pthread_cond_destroy(&r.cond);
+    pthread_mutex_destroy(&r.lock);
+    free(r.buf[0]);
+    fclose(r.f);
+    return r.error ? RSA_VERIFY_ERROR : RSA_VERIFY_OK;
+}
+
+#ifndef _WIN32
+static rsa_verify_result_t rsa_file_hash_mmap(const char *path, rsa_verify_ctx_t *ctx, uint64_t *bytes) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return RSA_VERIFY_ERROR;
+    struct stat st;
+    // An empty file cannot be mapped (and is rejected by rsa_verify_final anyway)
+    if (fstat(fd, &st) != 0 || st.st_size <= 0 || (uint64_t)st.st_size > SIZE_MAX) {
+        close(fd);
+        return RSA_VERIFY_ERROR;
+    }
+    size_t size = (size_t)st.st_size;
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return RSA_VERIFY_ERROR;
+    posix_madvise(map, size, POSIX_MADV_SEQUENTIAL);    // larger read-ahead, pages dropped early
+
+    rsa_verify_update(ctx, (const uint8_t *)map, size);
+    *bytes = size;
+    munmap(map, size);
+    return RSA_VERIFY_OK;
+}
+#endif
+
+rsa_verify_result_t rsa_verify_file(
+    const char *path, const rsa_public_key_t *key,
+    const uint8_t *signature, size_t sig_len,
+    rsa_file_io_t mode, rsa_file_stats_t *stats
+) {
+    if (stats) memset(stats, 0, sizeof(*stats));
+    if (!path || !key || !signature) return RSA_VERIFY_ERROR;
+    if (mode != RSA_FILE_IO_MMAP && mode != RSA_FILE_IO_THREADED) return RSA_VERIFY_ERROR;
+
+    // The signature names the digest, so it is decoded before the file is read;
+    // the signed digest is kept for the end, so the RSA operation runs once
+    rsa_verify_ctx_t ctx;
+    rsa_hash_alg_t alg;
+    uint8_t expected[RSA_MAX_DIGEST_SIZE];
+    rsa_verify_result_t result = rsa_signature_hash_alg(key, signature, sig_len, &alg, expected);
+    if (result != RSA_VERIFY_OK) return result;
+    result = rsa_verify_init_hash(&ctx, key, alg);
+    if (result != RSA_VERIFY_OK) return result;
+
+    uint64_t bytes = 0;
+    double start = rsa_file_now();
+#ifndef _WIN32
+    if (mode == RSA_FILE_IO_MMAP) {
+        result = rsa_file_hash_mmap(path, &ctx, &bytes);
+    } else
+#endif
+    {
+        result = rsa_file_hash_threaded(path, &ctx, &bytes);
+    }
+    double seconds = rsa_file_now() - start;
+
+    uint8_t digest[RSA_MAX_DIGEST_SIZE] = { 0 };
+    if (result == RSA_VERIFY_OK) {
+        result = rsa_verify_final_expected(&ctx, expected, digest);
+    }
+
+    if (stats) {
+        stats->bytes = bytes;
+        stats->seconds = seconds;
+        stats->bytes_per_sec = (seconds > 0) ? (double)bytes / seconds : 0;
+        stats->alg = alg;
+        memcpy(stats->digest, digest, sizeof(digest));
+        stats->cache_hit = false;
+    }
+    return result;
+}
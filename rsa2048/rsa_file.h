@@ -0,0 +1,57 @@
+#ifndef RSA_FILE_H
+#define RSA_FILE_H
+
+#include "rsa2048.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Size of each of the two buffers of RSA_FILE_IO_THREADED
+#ifndef RSA_FILE_CHUNK_SIZE
+#define RSA_FILE_CHUNK_SIZE (256 * 1024)
+#endif
+
+// How rsa_verify_file reads the file
+typedef enum {
+    RSA_FILE_IO_MMAP = 0,       // map it read-only with sequential access hints
+    RSA_FILE_IO_THREADED = 1    // reader thread filling two buffers in turn, hashed as they fill
+} rsa_file_io_t;
+
+// Read + hash throughput of one rsa_verify_file call (the RSA step is not
+// counted), and the file digest it found
+typedef struct {
+    uint64_t bytes;             // bytes hashed
+    double seconds;             // wall time from opening the file to the digest
+    double bytes_per_sec;       // bytes / seconds (0 when too fast to measure)
+    rsa_hash_alg_t alg;         // digest named by the signature
+    uint8_t digest[RSA_MAX_DIGEST_SIZE];    // file digest (unless the result is RSA_VERIFY_ERROR)
+    bool cache_hit;             // rsa_verify_file_cached answered from the cache (bytes is 0)
+} rsa_file_stats_t;
+
+/**
+ * Verify the signature of a file without loading it whole into memory.
+ * The signature is decoded first, and the file hashed with the digest its
+ * DigestInfo names (SHA-256, SHA-384 or SHA-512).
+ * With RSA_FILE_IO_MMAP the pages are read in by the kernel ahead of the
+ * hashing; with RSA_FILE_IO_THREADED the read of the next chunk overlaps the
+ * hashing of the current one. Which is faster depends on the storage, hence
+ * the throughput report. Where mmap is not available (Windows), MMAP falls
+ * back to THREADED.
+ *
+ * @param path: File to verify
+ * @param key: Public key built by rsa_public_key_init
+ * @param signature: RSA signature bytes (big-endian)
+ * @param sig_len: Signature length (should be key->mod_len)
+ * @param mode: RSA_FILE_IO_MMAP or RSA_FILE_IO_THREADED
+ * @param stats: Receives the read + hash throughput and the digest (may be NULL);
+ *               all zero when the signature is rejected before the file is read
+ * @return RSA_VERIFY_OK if signature is valid, RSA_VERIFY_ERROR if the file
+ *         cannot be read or is empty, error code otherwise
+ */
+rsa_verify_result_t rsa_verify_file(
+    const char *path, const rsa_public_key_t *key,
+    const uint8_t *signature, size_t sig_len,
+    rsa_file_io_t mode, rsa_file_stats_t *stats
+);
+
+#endif // RSA_FILE_H
@@ -0,0 +1,510 @@
+
+#ifdef _WIN32
+#define _CRT_RAND_S     // rand_s
+#endif
+#include <string.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "rsa_keygen.h"
+
+// Odd primes below this limit sieve the candidates before Miller-Rabin
+#define RSA_KEYGEN_SIEVE_LIMIT  32768
+#define RSA_KEYGEN_SMALL_PRIMES 3511    // odd primes below RSA_KEYGEN_SIEVE_LIMIT
+// Odd candidates start, start + 2, ... sieved per random start
+#define RSA_KEYGEN_SIEVE_SIZE   4096
+#define RSA_KEYGEN_MAX_THREADS  64
+
+static uint16_t rsa_small_primes[RSA_KEYGEN_SMALL_PRIMES];
+static pthread_once_t rsa_small_primes_once = PTHREAD_ONCE_INIT;
+
+// Shared state of one parallel prime search
+typedef struct {
+    size_t prime_bits;
+    uint32_t exponent;
+    rsa_random_fn rng;
+    void *rng_ctx;
+    atomic_bool done;                       // set by the first worker to finish (or fail)
+    pthread_mutex_t lock;
+    rsa_keygen_result_t status;
+    bigIntWord_t prime[BIGINT_MAX_MOD_WORDS];
+    uint32_t prime_length;                  // in words
+} rsa_prime_search_t;
+
+// Eratosthenes over the odd numbers below RSA_KEYGEN_SIEVE_LIMIT
+static void rsa_small_primes_init(void) {
+    static uint8_t composite[RSA_KEYGEN_SIEVE_LIMIT / 2];
+    size_t count = 0;
+    for (uint32_t i = 1; i < RSA_KEYGEN_SIEVE_LIMIT / 2; i++) {
+        if (composite[i]) continue;
+        uint32_t p = 2 * i + 1;
+        rsa_small_primes[count++] = (uint16_t)p;
+        for (uint32_t j = p * p / 2; j < RSA_KEYGEN_SIEVE_LIMIT / 2; j += p) {
+            composite[j] = 1;
+        }
+    }
+}
+
+// Number of significant bits of a
+static size_t rsa_bit_length(const bigInt_t *a) {
+    size_t bits = (size_t)(a->length - 1) * BIGINT_WORD_BITS;
+    for (bigIntWord_t top = a->words[a->length - 1]; top; top >>= 1) bits++;
+    return bits;
+}
+
+// a mod m for a word-sized m, 32 bits at a time
+static uint32_t rsa_mod_u32(const bigInt_t *a, uint32_t m) {
+    uint64_t r = 0;
+    for (size_t i = a->length; i-- > 0;) {
+        bigIntWord_t w = a->words[i];
+#if BIGINT_WORD_BITS == 64
+        r = ((r << 32) | (uint32_t)(w >> 32)) % m;
+#endif
+        r = ((r << 32) | (uint32_t)w) % m;
+    }
+    return (uint32_t)r;
+}
+
+static uint32_t rsa_gcd_u32(uint32_t a, uint32_t b) {
+    while (b) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// a^-1 mod m, or 0 if a and m are not coprime
+static uint32_t rsa_inverse_u32(uint32_t a, uint32_t m) {
+    int64_t r0 = m, r1 = a % m, t0 = 0, t1 = 1;
+    while (r1) {
+        int64_t q = r0 / r1, tmp;
+        tmp = r0 - q * r1; r0 = r1; r1 = tmp;
+        tmp = t0 - q * t1; t0 = t1; t1 = tmp;
+    }
+    if (r0 != 1) return 0;
+    return (uint32_t)((t0 < 0) ? t0 + m : t0);
+}
+
+// Miller-Rabin rounds for a probable-prime error of 2^-100 (FIPS 186-4, table C.2)
+static unsigned rsa_mr_rounds(size_t prime_bits) {
+    return (prime_bits >= 1536) ? 4 : (prime_bits >= 1024) ? 5 : 7;
+}
+
+/*
+ * Miller-Rabin with random bases on an odd n of s->prime_bits bits.
+ * Returns 1 for a probable prime, 0 for a composite (or when another worker
+ * already finished), -1 if the random source failed.
+ */
+static int rsa_miller_rabin(const bigInt_t *n, rsa_prime_search_t *s) {
+    BIGINT_DEFINE(n1, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(d, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(a, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(y, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(one, 1);
+    bigIntMontCtx_t ctx;
+    uint8_t buf[RSA_MAX_MODULUS_BYTES / 2];
+    size_t bytes = s->prime_bits / 8;
+
+    if (bigint_mont_init(&ctx, n) != BIGINT_OK) return 0;
+    bigint_from_uint32(&one, 1);
+
+    // n - 1 = d * 2^r with d odd
+    bigint_sub(&n1, n, &one);
+    bigint_copy(&d, &n1);
+    size_t r = 0;
+    while (!(d.words[0] & 1)) {
+        bigint_shift_right(&d, 1);
+        r++;
+    }
+
+    for (unsigned round = rsa_mr_rounds(s->prime_bits); round > 0; round--) {
+        if (atomic_load(&s->done)) return 0;
+
+        // Base in [2, 2^(bits - 2)), below n - 1
+        if (s->rng(s->rng_ctx, buf, bytes) != 0) return -1;
+        buf[0] &= 0x3F;
+        bigint_from_bytes(&a, buf, bytes);
+        if (a.length == 1 && a.words[0] < 2) a.words[0] += 2;
+
+        if (bigint_mont_exp(&y, &a, &d, &ctx) != BIGINT_OK) return 0;
+        if (bigint_compare(&y, &one) == 0 || bigint_compare(&y, &n1) == 0) continue;
+
+        bool witness = true;
+        for (size_t i = 1; i < r; i++) {
+            bigint_mont_exp_uint(&y, &y, 2, &ctx);
+            if (bigint_compare(&y, &n1) == 0) {
+                witness = false;
+                break;
+            }
+            if (bigint_compare(&y, &one) == 0) break;
+        }
+        if (witness) return 0;
+    }
+    return 1;
+}
+
+// Records the outcome of a worker; only the first one counts
+static void rsa_prime_search_finish(rsa_prime_search_t *s, rsa_keygen_result_t status, const bigInt_t *prime) {
+    pthread_mutex_lock(&s->lock);
+    if (!atomic_load(&s->done)) {
+        s->status = status;
+        if (prime) {
+            memcpy(s->prime, prime->words, prime->length * BIGINT_WORD_BYTES);
+            s->prime_length = prime->length;
+        }
+        atomic_store(&s->done, true);
+    }
+    pthread_mutex_unlock(&s->lock);
+}
+
+/*
+ * Prime search worker: from a random odd start with the top two bits set,
+ * sieves RSA_KEYGEN_SIEVE_SIZE odd candidates by the small primes (one
+ * residue per prime, then every p-th offset is crossed out), skips those with
+ * gcd(p - 1, e) != 1 and runs Miller-Rabin on the rest.
+ */
+static void *rsa_prime_worker(void *arg) {
+    rsa_prime_search_t *s = (rsa_prime_search_t *)arg;
+    BIGINT_DEFINE(start, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(candidate, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(offset, 1);
+    uint16_t residues[RSA_KEYGEN_SMALL_PRIMES];
+    uint8_t sieve[RSA_KEYGEN_SIEVE_SIZE];
+    uint8_t buf[RSA_MAX_MODULUS_BYTES / 2];
+    size_t bytes = s->prime_bits / 8;
+    uint32_t e = s->exponent;
+
+    while (!atomic_load(&s->done)) {
+        if (s->rng(s->rng_ctx, buf, bytes) != 0) {
+            rsa_prime_search_finish(s, RSA_KEYGEN_RANDOM_ERROR, NULL);
+            break;
+        }
+        buf[0] |= 0xC0;             // p * q keeps the full modulus size
+        buf[bytes - 1] |= 1;
+        bigint_from_bytes(&start, buf, bytes);
+
+        memset(sieve, 0, sizeof(sieve));
+        for (size_t i = 0; i < RSA_KEYGEN_SMALL_PRIMES; i++) {
+            uint32_t p = rsa_small_primes[i];
+            residues[i] = (uint16_t)rsa_mod_u32(&start, p);
+            // start + 2j = 0 (mod p) at j = -residue / 2 (mod p)
+            uint32_t j = ((p - residues[i]) % p) * ((p + 1) / 2) % p;
+            for (; j < RSA_KEYGEN_SIEVE_SIZE; j += p) sieve[j] = 1;
+        }
+        uint32_t start_mod_e = rsa_mod_u32(&start, e);
+
+        for (uint32_t j = 0; j < RSA_KEYGEN_SIEVE_SIZE && !atomic_load(&s->done); j++) {
+            if (sieve[j]) continue;
+            uint32_t pm1_mod_e = (uint32_t)(((uint64_t)start_mod_e + 2 * (uint64_t)j + e - 1) % e);
+            if (rsa_gcd_u32(pm1_mod_e, e) != 1) continue;
+
+            bigint_from_uint32(&offset, 2 * j);
+            bigint_add(&candidate, &start, &offset);
+            if (rsa_bit_length(&candidate) != s->prime_bits) break;
+
+            int mr = rsa_miller_rabin(&candidate, s);
+            if (mr < 0) {
+                rsa_prime_search_finish(s, RSA_KEYGEN_RANDOM_ERROR, NULL);
+                return NULL;
+            }
+            if (mr > 0) {
+                rsa_prime_search_finish(s, RSA_KEYGEN_OK, &candidate);
+                return NULL;
+            }
+        }
+    }
+    return NULL;
+}
+
+// Finds a prime of prime_bits bits on `threads` workers
+static rsa_keygen_result_t rsa_find_prime(bigInt_t *prime, size_t prime_bits, uint32_t exponent,
+                                          unsigned threads, rsa_random_fn rng, void *rng_ctx) {
+    rsa_prime_search_t *s = malloc(sizeof(*s));
+    if (!s) return RSA_KEYGEN_NO_MEMORY;
+    s->prime_bits = prime_bits;
+    s->exponent = exponent;
+    s->rng = rng;
+    s->rng_ctx = rng_ctx;
+    s->status = RSA_KEYGEN_ERROR;
+    s->prime_length = 0;
+    atomic_init(&s->done, false);
+    pthread_mutex_init(&s->lock, NULL);
+
+    pthread_t workers[RSA_KEYGEN_MAX_THREADS];
+    unsigned started = 0;
+    for (unsigned i = 0; i < threads; i++) {
+        if (pthread_create(&workers[started], NULL, rsa_prime_worker, s) == 0) started++;
+    }
+    if (started == 0) {
+        rsa_prime_worker(s);
+    }
+    for (unsigned i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    rsa_keygen_result_t status = s->status;
+    if (status == RSA_KEYGEN_OK) {
+        bigint_zero(prime);
+        memcpy(prime->words, s->prime, s->prime_length * BIGINT_WORD_BYTES);
+        prime->length = s->prime_length;
+    }
+    pthread_mutex_destroy(&s->lock);
+    free(s);
+    return status;
+}
+
+int rsa_random_os(void *ctx, uint8_t *buf, size_t len) {
+    (void)ctx;
+#ifdef _WIN32
+    while (len > 0) {
+        unsigned int r;
+        if (rand_s(&r) != 0) return -1;
+        size_t n = (len < sizeof(r)) ? len : sizeof(r);
+        memcpy(buf, &r, n);
+        buf += n;
+        len -= n;
+    }
+    return 0;
+#else
+    int fd = open("/dev/urandom", O_RDONLY);
+    if (fd < 0) return -1;
+    while (len > 0) {
+        ssize_t n = read(fd, buf, len);
+        if (n <= 0) {
+            close(fd);
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    close(fd);
+    return 0;
+#endif
+}
+
+/*
+ * Derives n, d and the CRT values from two primes. Returns RSA_KEYGEN_OK, or
+ * RSA_KEYGEN_ERROR when the pair has to be redrawn (d too small, failed
+ * consistency check).
+ */
+static rsa_keygen_result_t rsa_derive_key(rsa_private_key_t *key, const bigInt_t *p, const bigInt_t *q,
+                                          size_t bits, uint32_t exponent) {
+    BIGINT_DEFINE(n, BIGINT_MAX_WORDS);
+    BIGINT_DEFINE(p1, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(q1, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(g, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(h, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(t, BIGINT_MAX_WORDS);
+    BIGINT_DEFINE(lambda, BIGINT_MAX_WORDS);
+    BIGINT_DEFINE(d, BIGINT_MAX_WORDS);
+    BIGINT_DEFINE(rem, BIGINT_MAX_WORDS);
+    BIGINT_DEFINE(small, 1);
+    BIGINT_DEFINE(dp, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(dq, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(qinv, BIGINT_MAX_MOD_WORDS);
+    bigIntMontCtx_t ctx;
+    size_t half = bits / 16;
+
+    if (bigint_mul(&n, p, q) != BIGINT_OK || rsa_bit_length(&n) != bits) return RSA_KEYGEN_ERROR;
+
+    // lambda = lcm(p - 1, q - 1) = (p - 1)(q - 1) / gcd(p - 1, q - 1)
+    bigint_from_uint32(&small, 1);
+    bigint_sub(&p1, p, &small);
+    bigint_sub(&q1, q, &small);
+    bigint_copy(&g, &p1);
+    bigint_copy(&h, &q1);
+    while (!bigint_is_zero(&h)) {
+        if (bigint_mod(&t, &g, &h) != BIGINT_OK) return RSA_KEYGEN_ERROR;
+        bigint_copy(&g, &h);
+        bigint_copy(&h, &t);
+    }
+    if (bigint_mul(&t, &p1, &q1) != BIGINT_OK ||
+        bigint_divmod(&lambda, &rem, &t, &g) != BIGINT_OK) {
+        return RSA_KEYGEN_ERROR;
+    }
+
+    // d = (k * lambda + 1) / e with k = -lambda^-1 mod e, so e divides it exactly
+    uint32_t inv = rsa_inverse_u32(rsa_mod_u32(&lambda, exponent), exponent);
+    if (inv == 0) return RSA_KEYGEN_ERROR;
+    bigint_from_uint32(&small, exponent - inv);
+    if (bigint_mul(&t, &lambda, &small) != BIGINT_OK) return RSA_KEYGEN_ERROR;
+    bigint_from_uint32(&small, 1);
+    bigint_add(&t, &t, &small);
+    bigint_from_uint32(&small, exponent);
+    if (bigint_divmod(&d, &rem, &t, &small) != BIGINT_OK || !bigint_is_zero(&rem)) {
+        return RSA_KEYGEN_ERROR;
+    }
+    // FIPS 186-4 B.3.1: d > 2^(nlen / 2)
+    if (rsa_bit_length(&d) <= bits / 2) return RSA_KEYGEN_ERROR;
+
+    // CRT values; q^-1 mod p = q^(p - 2) mod p for a prime p
+    if (bigint_mod(&dp, &d, &p1) != BIGINT_OK || bigint_mod(&dq, &d, &q1) != BIGINT_OK) {
+        return RSA_KEYGEN_ERROR;
+    }
+    bigint_from_uint32(&small, 1);
+    bigint_sub(&t, &p1, &small);
+    if (bigint_mont_init(&ctx, p) != BIGINT_OK || bigint_mont_exp(&qinv, q, &t, &ctx) != BIGINT_OK) {
+        return RSA_KEYGEN_ERROR;
+    }
+
+    // Pairwise consistency: (2^e)^d = 2 (mod n)
+    bigint_from_uint32(&small, 2);
+    if (bigint_mont_init(&ctx, &n) != BIGINT_OK ||
+        bigint_mont_exp_uint(&t, &small, exponent, &ctx) != BIGINT_OK ||
+        bigint_mont_exp(&rem, &t, &d, &ctx) != BIGINT_OK ||
+        bigint_compare(&rem, &small) != 0) {
+        return RSA_KEYGEN_ERROR;
+    }
+
+    key->mod_len = bits / 8;
+    key->exponent = exponent;
+    if (bigint_to_bytes(&n, key->modulus, bits / 8) != BIGINT_OK ||
+        bigint_to_bytes(&d, key->private_exponent, bits / 8) != BIGINT_OK ||
+        bigint_to_bytes(p, key->prime1, half) != BIGINT_OK ||
+        bigint_to_bytes(q, key->prime2, half) != BIGINT_OK ||
+        bigint_to_bytes(&dp, key->exponent1, half) != BIGINT_OK ||
+        bigint_to_bytes(&dq, key->exponent2, half) != BIGINT_OK ||
+        bigint_to_bytes(&qinv, key->coefficient, half) != BIGINT_OK) {
+        return RSA_KEYGEN_ERROR;
+    }
+    return RSA_KEYGEN_OK;
+}
+
+rsa_keygen_result_t rsa_generate_key(
+    rsa_private_key_t *key,
+    unsigned bits, uint32_t exponent,
+    unsigned threads,
+    rsa_random_fn rng, void *rng_ctx
+) {
+    BIGINT_DEFINE(p, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(q, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(diff, BIGINT_MAX_MOD_WORDS);
+    if (!key || bits < RSA_KEYGEN_MIN_BITS || bits > BIGINT_MAX_MOD_BITS || bits % 16 != 0 ||
+        exponent < 3 || !(exponent & 1)) {
+        return RSA_KEYGEN_ERROR;
+    }
+    if (!rng) rng = rsa_random_os;
+    if (threads == 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (unsigned)cpus : 1;
+#else
+        threads = 1;
+#endif
+    }
+    if (threads > RSA_KEYGEN_MAX_THREADS) threads = RSA_KEYGEN_MAX_THREADS;
+    pthread_once(&rsa_small_primes_once, rsa_small_primes_init);
+
+    size_t prime_bits = bits / 2;
+    for (;;) {
+        rsa_keygen_result_t status = rsa_find_prime(&p, prime_bits, exponent, threads, rng, rng_ctx);
+        if (status != RSA_KEYGEN_OK) return status;
+        status = rsa_find_prime(&q, prime_bits, exponent, threads, rng, rng_ctx);
+        if (status != RSA_KEYGEN_OK) return status;
+
+        // FIPS 186-4 B.3.3: |p - q| > 2^(nlen / 2 - 100)
+        if (bigint_compare(&p, &q) >= 0) {
+            bigint_sub(&diff, &p, &q);
+        } else {
+            bigint_sub(&diff, &q, &p);
+        }
+        if (bigint_is_zero(&diff) || rsa_bit_length(&diff) <= prime_bits - 100) continue;
+
+        if (rsa_derive_key(key, &p, &q, bits, exponent) == RSA_KEYGEN_OK) return RSA_KEYGEN_OK;
+    }
+}
+
+rsa_keygen_result_t rsa_private_key_write_c(const rsa_private_key_t *key, FILE *out) {
+    if (!key || !out) return RSA_KEYGEN_ERROR;
+
+    // Same layout as convert_keys.py: 16 bytes per row, an extra space after the 8th
+    size_t len = key->mod_len;
+    fprintf(out, "const uint8_t rsa_modulus[%zu] = {\n", len);
+    for (size_t i = 0; i < len; i += 16) {
+        fputs("    ", out);
+        for (size_t j = 0; j < 16; j++) {
+            if (i + j < len) {
+                fprintf(out, "0x%02X", key->modulus[i + j]);
+                if (i + j < len - 1) fputs(", ", out);
+            }
+            if (j == 7) fputc(' ', out);
+        }
+        fputc('\n', out);
+    }
+    fputs("};\n\n", out);
+    fprintf(out, "const uint32_t rsa_exponent = 0x%X;\n\n", (unsigned)key->exponent);
+    return ferror(out) ? RSA_KEYGEN_ERROR : RSA_KEYGEN_OK;
+}
+
+rsa_keygen_result_t rsa_private_key_sign(
+    const rsa_private_key_t *key,
+    rsa_hash_alg_t alg,
+    const uint8_t *message, size_t message_len,
+    uint8_t *signature
+) {
+    BIGINT_DEFINE(n, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(d, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(m, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(s, BIGINT_MAX_MOD_WORDS);
+    BIGINT_DEFINE(check, BIGINT_MAX_MOD_WORDS);
+    bigIntMontCtx_t ctx;
+    uint8_t block[RSA_MAX_MODULUS_BYTES];
+    const uint8_t *prefix;
+    size_t prefix_len, digest_len;
+    switch (alg) {
+    case RSA_HASH_SHA256:
+        prefix = RSA_PKCS1_SHA256_PREFIX;
+        prefix_len = RSA_PKCS1_SHA256_PREFIX_LEN;
+        digest_len = SHA256_DIGEST_SIZE;
+        break;
+    case RSA_HASH_SHA384:
+        prefix = RSA_PKCS1_SHA384_PREFIX;
+        prefix_len = RSA_PKCS1_SHA384_PREFIX_LEN;
+        digest_len = SHA384_DIGEST_SIZE;
+        break;
+    case RSA_HASH_SHA512:
+        prefix = RSA_PKCS1_SHA512_PREFIX;
+        prefix_len = RSA_PKCS1_SHA512_PREFIX_LEN;
+        digest_len = SHA512_DIGEST_SIZE;
+        break;
+    default:
+        return RSA_KEYGEN_ERROR;
+    }
+    size_t len = key ? key->mod_len : 0;
+    size_t t_len = prefix_len + digest_len;
+    if (!key || !signature || (!message && message_len) ||
+        len < t_len + 11 || len > RSA_MAX_MODULUS_BYTES) {
+        return RSA_KEYGEN_ERROR;
+    }
+
+    // 0x00 0x01 FF..FF 0x00 || DigestInfo || digest (RFC 8017, section 9.2)
+    block[0] = 0x00;
+    block[1] = 0x01;
+    memset(block + 2, 0xFF, len - t_len - 3);
+    block[len - t_len - 1] = 0x00;
+    memcpy(block + len - t_len, prefix, prefix_len);
+    if (alg == RSA_HASH_SHA256) {
+        sha256_hash(message, message_len, block + len - digest_len);
+    } else if (alg == RSA_HASH_SHA384) {
+        sha384_hash(message, message_len, block + len - digest_len);
+    } else {
+        sha512_hash(message, message_len, block + len - digest_len);
+    }
+
+    // s = m^d mod n, then s^e must give the block back
+    if (bigint_from_bytes(&n, key->modulus, len) != BIGINT_OK ||
+        bigint_from_bytes(&d, key->private_exponent, len) != BIGINT_OK ||
+        bigint_from_bytes(&m, block, len) != BIGINT_OK ||
+        bigint_mont_init(&ctx, &n) != BIGINT_OK ||
+        bigint_mont_exp(&s, &m, &d, &ctx) != BIGINT_OK ||
+        bigint_mont_exp_uint(&check, &s, key->exponent, &ctx) != BIGINT_OK ||
+        bigint_compare(&check, &m) != 0) {
+        return RSA_KEYGEN_ERROR;
+    }
+    return (bigint_to_bytes(&s, signature, len) == BIGINT_OK) ? RSA_KEYGEN_OK : RSA_KEYGEN_ERROR;
+}
@@ -0,0 +1,95 @@
+#ifndef RSA_KEYGEN_H
+#define RSA_KEYGEN_H
+
+#include "rsa2048.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Smallest modulus rsa_generate_key produces
+#define RSA_KEYGEN_MIN_BITS 1024
+
+typedef enum {
+    RSA_KEYGEN_OK = 0,
+    RSA_KEYGEN_ERROR = -1,          // bad argument (size, exponent) or write failure
+    RSA_KEYGEN_RANDOM_ERROR = -2,   // the random source failed
+    RSA_KEYGEN_NO_MEMORY = -3
+} rsa_keygen_result_t;
+
+// Fills buf with len random bytes, returns 0 on success. Called from several
+// threads at once, so it must be thread-safe.
+typedef int (*rsa_random_fn)(void *ctx, uint8_t *buf, size_t len);
+
+// RSA private key, all integers big-endian and zero-padded to their field size
+typedef struct {
+    size_t mod_len;                                         // modulus length in bytes
+    uint8_t modulus[RSA_MAX_MODULUS_BYTES];                 // n = p * q (mod_len bytes)
+    uint32_t exponent;                                      // e
+    uint8_t private_exponent[RSA_MAX_MODULUS_BYTES];        // d = e^-1 mod lcm(p - 1, q - 1) (mod_len bytes)
+    uint8_t prime1[RSA_MAX_MODULUS_BYTES / 2];              // p (mod_len / 2 bytes, as the rest below)
+    uint8_t prime2[RSA_MAX_MODULUS_BYTES / 2];              // q
+    uint8_t exponent1[RSA_MAX_MODULUS_BYTES / 2];           // d mod (p - 1)
+    uint8_t exponent2[RSA_MAX_MODULUS_BYTES / 2];           // d mod (q - 1)
+    uint8_t coefficient[RSA_MAX_MODULUS_BYTES / 2];         // q^-1 mod p
+} rsa_private_key_t;
+
+/**
+ * Random source backed by the operating system (/dev/urandom, rand_s on Windows)
+ *
+ * @param ctx: Unused
+ * @param buf: Output buffer
+ * @param len: Number of bytes
+ * @return 0 on success, -1 on failure
+ */
+int rsa_random_os(void *ctx, uint8_t *buf, size_t len);
+
+/**
+ * Generate an RSA key pair. Primes are searched on several threads at once
+ * (small-prime sieve, then Miller-Rabin with the FIPS 186-4 round counts).
+ *
+ * @param key: Receives the private key (the public part is modulus/exponent)
+ * @param bits: Modulus size, a multiple of 16 from RSA_KEYGEN_MIN_BITS to BIGINT_MAX_MOD_BITS
+ * @param exponent: Public exponent, odd and at least 3 (typically 65537)
+ * @param threads: Worker threads for the prime search (0: one per online CPU)
+ * @param rng: Random source (NULL: rsa_random_os)
+ * @param rng_ctx: Passed to rng
+ * @return RSA_KEYGEN_OK on success, error code otherwise
+ */
+rsa_keygen_result_t rsa_generate_key(
+    rsa_private_key_t *key,
+    unsigned bits, uint32_t exponent,
+    unsigned threads,
+    rsa_random_fn rng, void *rng_ctx
+);
+
+/**
+ * Write the public key as the rsa_modulus / rsa_exponent definitions of
+ * rsakeys/rsa_keys.c, in the same format genkey/convert_keys.py produces
+ *
+ * @param key: Generated key
+ * @param out: Output stream
+ * @return RSA_KEYGEN_OK on success, RSA_KEYGEN_ERROR on a write failure
+ */
+rsa_keygen_result_t rsa_private_key_write_c(const rsa_private_key_t *key, FILE *out);
+
+/**
+ * Sign a message with the private exponent (PKCS#1 v1.5), the signature
+ * rsa_verify_with_key accepts. The result is checked against the public
+ * exponent before it is returned. Not constant time: meant for the
+ * provisioning host, not for the device.
+ *
+ * @param key: Generated key
+ * @param alg: Message digest (SHA-256, SHA-384 or SHA-512)
+ * @param message: Message data to sign
+ * @param message_len: Length of message
+ * @param signature: Receives key->mod_len signature bytes (big-endian)
+ * @return RSA_KEYGEN_OK on success, RSA_KEYGEN_ERROR otherwise
+ */
+rsa_keygen_result_t rsa_private_key_sign(
+    const rsa_private_key_t *key,
+    rsa_hash_alg_t alg,
+    const uint8_t *message, size_t message_len,
+    uint8_t *signature
+);
+
+#endif // RSA_KEYGEN_H
@@ -0,0 +1,195 @@
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include "rsa_keyring.h"
+
+#define RSA_KEYRING_INITIAL_BUCKETS 16
+
+struct rsa_keyring_entry {
+    rsa_public_key_t key;            // first member: rsa_keyring_release casts back from it
+    uint8_t id[RSA_KEY_ID_SIZE];
+    atomic_uint refs;                // one for the keyring while linked, one per acquire
+    struct rsa_keyring_entry *next;
+};
+
+// Key IDs are SHA-256 outputs, so their low bytes are already a uniform hash
+static size_t rsa_keyring_bucket(const uint8_t id[RSA_KEY_ID_SIZE], size_t bucket_count) {
+    size_t h = 0;
+    for (size_t i = 0; i < sizeof(size_t); i++) {
+        h |= (size_t)id[i] << (8 * i);
+    }
+    return h & (bucket_count - 1);
+}
+
+// Entry with the given ID, or NULL (lock held)
+static rsa_keyring_entry_t *rsa_keyring_find(const rsa_keyring_t *ring, const uint8_t id[RSA_KEY_ID_SIZE]) {
+    rsa_keyring_entry_t *e = ring->buckets[rsa_keyring_bucket(id, ring->bucket_count)];
+    while (e && memcmp(e->id, id, RSA_KEY_ID_SIZE) != 0) {
+        e = e->next;
+    }
+    return e;
+}
+
+// Doubles the bucket array (write lock held); on allocation failure the
+// keyring just stays at its current size
+static void rsa_keyring_grow(rsa_keyring_t *ring) {
+    size_t bucket_count = ring->bucket_count * 2;
+    rsa_keyring_entry_t **buckets = calloc(bucket_count, sizeof(*buckets));
+    if (!buckets) return;
+
+    for (size_t i = 0; i < ring->bucket_count; i++) {
+        rsa_keyring_entry_t *e = ring->buckets[i];
+        while (e) {
+            rsa_keyring_entry_t *next = e->next;
+            size_t b = rsa_keyring_bucket(e->id, bucket_count);
+            e->next = buckets[b];
+            buckets[b] = e;
+            e = next;
+        }
+    }
+    free(ring->buckets);
+    ring->buckets = buckets;
+    ring->bucket_count = bucket_count;
+}
+
+void rsa_key_id(const uint8_t *modulus, size_t mod_len, uint8_t id[RSA_KEY_ID_SIZE]) {
+    // Same ID whether or not the modulus comes with a leading zero byte
+    while (mod_len > 0 && modulus[0] == 0) {
+        modulus++;
+        mod_len--;
+    }
+    sha256_hash(modulus, mod_len, id);
+}
+
+rsa_keyring_result_t rsa_keyring_init(rsa_keyring_t *ring) {
+    if (!ring) return RSA_KEYRING_ERROR;
+
+    ring->buckets = calloc(RSA_KEYRING_INITIAL_BUCKETS, sizeof(*ring->buckets));
+    if (!ring->buckets) return RSA_KEYRING_NO_MEMORY;
+    ring->bucket_count = RSA_KEYRING_INITIAL_BUCKETS;
+    ring->count = 0;
+
+    if (pthread_rwlock_init(&ring->lock, NULL) != 0) {
+        free(ring->buckets);
+        ring->buckets = NULL;
+        return RSA_KEYRING_ERROR;
+    }
+    return RSA_KEYRING_OK;
+}
+
+void rsa_keyring_free(rsa_keyring_t *ring) {
+    if (!ring || !ring->buckets) return;
+
+    for (size_t i = 0; i < ring->bucket_count; i++) {
+        rsa_keyring_entry_t *e = ring->buckets[i];
+        while (e) {
+            rsa_keyring_entry_t *next = e->next;
+            rsa_keyring_release(&e->key);
+            e = next;
+        }
+    }
+    free(ring->buckets);
+    ring->buckets = NULL;
+    ring->bucket_count = 0;
+    ring->count = 0;
+    pthread_rwlock_destroy(&ring->lock);
+}
+
+rsa_keyring_result_t rsa_keyring_add(
+    rsa_keyring_t *ring,
+    const uint8_t *modulus, size_t mod_len,
+    uint32_t exponent,
+    uint8_t id[RSA_KEY_ID_SIZE]
+) {
+    if (!ring || !modulus) return RSA_KEYRING_ERROR;
+
+    // Keys are stored at their canonical length, so a modulus in DER form
+    // (leading 0x00) takes the mod_len-byte signatures of the same key
+    while (mod_len > 0 && modulus[0] == 0) {
+        modulus++;
+        mod_len--;
+    }
+
+    // The expensive part (Montgomery setup) runs before taking the lock
+    rsa_keyring_entry_t *entry = malloc(sizeof(*entry));
+    if (!entry) return RSA_KEYRING_NO_MEMORY;
+    if (rsa_public_key_init(&entry->key, modulus, mod_len, exponent) != RSA_VERIFY_OK) {
+        free(entry);
+        return RSA_KEYRING_ERROR;
+    }
+    rsa_key_id(modulus, mod_len, entry->id);
+    atomic_init(&entry->refs, 1);
+    if (id) memcpy(id, entry->id, RSA_KEY_ID_SIZE);
+
+    pthread_rwlock_wrlock(&ring->lock);
+    if (rsa_keyring_find(ring, entry->id)) {
+        pthread_rwlock_unlock(&ring->lock);
+        free(entry);
+        return RSA_KEYRING_EXISTS;
+    }
+    if (ring->count >= ring->bucket_count) {
+        rsa_keyring_grow(ring);
+    }
+    size_t b = rsa_keyring_bucket(entry->id, ring->bucket_count);
+    entry->next = ring->buckets[b];
+    ring->buckets[b] = entry;
+    ring->count++;
+    pthread_rwlock_unlock(&ring->lock);
+    return RSA_KEYRING_OK;
+}
+
+rsa_keyring_result_t rsa_keyring_remove(rsa_keyring_t *ring, const uint8_t id[RSA_KEY_ID_SIZE]) {
+    if (!ring || !id) return RSA_KEYRING_ERROR;
+
+    pthread_rwlock_wrlock(&ring->lock);
+    rsa_keyring_entry_t **link = &ring->buckets[rsa_keyring_bucket(id, ring->bucket_count)];
+    while (*link && memcmp((*link)->id, id, RSA_KEY_ID_SIZE) != 0) {
+        link = &(*link)->next;
+    }
+    rsa_keyring_entry_t *entry = *link;
+    if (entry) {
+        *link = entry->next;
+        ring->count--;
+    }
+    pthread_rwlock_unlock(&ring->lock);
+
+    if (!entry) return RSA_KEYRING_NOT_FOUND;
+    // Drop the keyring's reference; pinned users keep the entry alive
+    rsa_keyring_release(&entry->key);
+    return RSA_KEYRING_OK;
+}
+
+const rsa_public_key_t *rsa_keyring_acquire(rsa_keyring_t *ring, const uint8_t id[RSA_KEY_ID_SIZE]) {
+    if (!ring || !id) return NULL;
+
+    pthread_rwlock_rdlock(&ring->lock);
+    rsa_keyring_entry_t *entry = rsa_keyring_find(ring, id);
+    if (entry) {
+        atomic_fetch_add_explicit(&entry->refs, 1, memory_order_relaxed);
+    }
+    pthread_rwlock_unlock(&ring->lock);
+    return entry ? &entry->key : NULL;
+}
+
+void rsa_keyring_release(const rsa_public_key_t *key) {
+    if (!key) return;
+
+    rsa_keyring_entry_t *entry = (rsa_keyring_entry_t *)key;
+    if (atomic_fetch_sub_explicit(&entry->refs, 1, memory_order_acq_rel) == 1) {
+        free(entry);
+    }
+}
+
+rsa_verify_result_t rsa_verify_with_key_id(
+    rsa_keyring_t *ring, const uint8_t id[RSA_KEY_ID_SIZE],
+    const uint8_t *message, size_t message_len,
+    const uint8_t *signature, size_t sig_len
+) {
+    const rsa_public_key_t *key = rsa_keyring_acquire(ring, id);
+    if (!key) return RSA_VERIFY_UNKNOWN_KEY;
+
+    rsa_verify_result_t result = rsa_verify_with_key(key, message, message_len, signature, sig_len);
+    rsa_keyring_release(key);
+    return result;
+}
@@ -0,0 +1,120 @@
+#ifndef RSA_KEYRING_H
+#define RSA_KEYRING_H
+
+#include "rsa2048.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Key ID: SHA-256 of the modulus (big-endian, leading zero bytes stripped)
+#define RSA_KEY_ID_SIZE SHA256_DIGEST_SIZE
+
+typedef enum {
+    RSA_KEYRING_OK = 0,
+    RSA_KEYRING_ERROR = -1,        // bad argument or unusable key
+    RSA_KEYRING_NOT_FOUND = -2,
+    RSA_KEYRING_EXISTS = -3,       // a key with the same ID is already present
+    RSA_KEYRING_NO_MEMORY = -4
+} rsa_keyring_result_t;
+
+typedef struct rsa_keyring_entry rsa_keyring_entry_t;
+
+// Hash table of prepared public keys. Lookups take the lock shared and only
+// long enough to pin an entry; verifications run on the pinned key without
+// any lock, so adding or removing keys never waits for them.
+typedef struct {
+    rsa_keyring_entry_t **buckets;   // chained by entry, indexed by the low ID bits
+    size_t bucket_count;             // power of two
+    size_t count;                    // keys present
+    pthread_rwlock_t lock;
+} rsa_keyring_t;
+
+/**
+ * Compute the key ID of an RSA modulus
+ *
+ * @param modulus: RSA public key modulus (big-endian bytes)
+ * @param mod_len: Modulus length in bytes
+ * @param id: Receives the RSA_KEY_ID_SIZE byte key ID
+ */
+void rsa_key_id(const uint8_t *modulus, size_t mod_len, uint8_t id[RSA_KEY_ID_SIZE]);
+
+/**
+ * Initialize an empty keyring
+ *
+ * @param ring: Keyring to initialize
+ * @return RSA_KEYRING_OK on success, error code otherwise
+ */
+rsa_keyring_result_t rsa_keyring_init(rsa_keyring_t *ring);
+
+/**
+ * Destroy a keyring. No other thread may use it any more; keys still
+ * acquired stay valid until their release.
+ *
+ * @param ring: Keyring to destroy
+ */
+void rsa_keyring_free(rsa_keyring_t *ring);
+
+/**
+ * Prepare a public key and add it to the keyring
+ *
+ * @param ring: Keyring
+ * @param modulus: RSA public key modulus (big-endian bytes, odd; leading zero
+ *                 bytes, as in DER, are dropped)
+ * @param mod_len: Modulus length in bytes (at most RSA_MAX_MODULUS_BYTES
+ *                 without the leading zeros)
+ * @param exponent: RSA public exponent (typically 65537)
+ * @param id: Receives the key ID (may be NULL)
+ * @return RSA_KEYRING_OK on success, error code otherwise
+ */
+rsa_keyring_result_t rsa_keyring_add(
+    rsa_keyring_t *ring,
+    const uint8_t *modulus, size_t mod_len,
+    uint32_t exponent,
+    uint8_t id[RSA_KEY_ID_SIZE]
+);
+
+/**
+ * Remove a key from the keyring. Verifications already holding the key
+ * finish normally; its memory goes with the last release.
+ *
+ * @param ring: Keyring
+ * @param id: Key ID
+ * @return RSA_KEYRING_OK on success, RSA_KEYRING_NOT_FOUND if absent
+ */
+rsa_keyring_result_t rsa_keyring_remove(rsa_keyring_t *ring, const uint8_t id[RSA_KEY_ID_SIZE]);
+
+/**
+ * Look up a key and pin it for use outside the keyring lock
+ *
+ * @param ring: Keyring
+ * @param id: Key ID
+ * @return The key (pass it to rsa_keyring_release when done), NULL if absent
+ */
+const rsa_public_key_t *rsa_keyring_acquire(rsa_keyring_t *ring, const uint8_t id[RSA_KEY_ID_SIZE]);
+
+/**
+ * Unpin a key returned by rsa_keyring_acquire
+ *
+ * @param key: Key to release (NULL is ignored)
+ */
+void rsa_keyring_release(const rsa_public_key_t *key);
+
+/**
+ * Verify RSA signature (PKCS#1 v1.5, SHA-256/384/512) with a key from the keyring
+ *
+ * @param ring: Keyring
+ * @param id: ID of the signer's key
+ * @param message: Message data to verify
+ * @param message_len: Length of message
+ * @param signature: RSA signature bytes (big-endian)
+ * @param sig_len: Signature length (should be the modulus size)
+ * @return RSA_VERIFY_OK if signature is valid, RSA_VERIFY_UNKNOWN_KEY if the
+ *         ID is not in the keyring, error code otherwise
+ */
+rsa_verify_result_t rsa_verify_with_key_id(
+    rsa_keyring_t *ring, const uint8_t id[RSA_KEY_ID_SIZE],
+    const uint8_t *message, size_t message_len,
+    const uint8_t *signature, size_t sig_len
+);
+
+#endif // RSA_KEYRING_H
@@ -0,0 +1,215 @@
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+#include "rsa_manifest.h"
+
+#define RSA_MANIFEST_LEAF_PREFIX 0x00
+#define RSA_MANIFEST_NODE_PREFIX 0x01
+#define RSA_MANIFEST_MAX_THREADS 64
+
+// One hashing thread of rsa_manifest_verify_image: chunks [first, last)
+typedef struct {
+    const rsa_manifest_t *manifest;
+    const uint8_t *image;
+    size_t first, last;
+    atomic_bool *mismatch;      // shared: set by the first worker that finds one
+} rsa_manifest_worker_t;
+
+static uint32_t rsa_manifest_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint64_t rsa_manifest_be64(const uint8_t *p) {
+    return ((uint64_t)rsa_manifest_be32(p) << 32) | rsa_manifest_be32(p + 4);
+}
+
+static void rsa_manifest_node_hash(const uint8_t *left, const uint8_t *right, uint8_t *digest) {
+    uint8_t node[1 + 2 * SHA256_DIGEST_SIZE];
+    node[0] = RSA_MANIFEST_NODE_PREFIX;
+    memcpy(node + 1, left, SHA256_DIGEST_SIZE);
+    memcpy(node + 1 + SHA256_DIGEST_SIZE, right, SHA256_DIGEST_SIZE);
+    sha256_hash(node, sizeof(node), digest);
+}
+
+// Length of chunk `index`: chunk_size, except for a shorter last chunk
+static size_t rsa_manifest_chunk_len(const rsa_manifest_t *manifest, size_t index) {
+    uint64_t left = manifest->image_size - (uint64_t)index * manifest->chunk_size;
+    return (left < manifest->chunk_size) ? (size_t)left : manifest->chunk_size;
+}
+
+static bool rsa_manifest_chunk_matches(const rsa_manifest_t *manifest, size_t index, const uint8_t *chunk) {
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    rsa_manifest_leaf_hash(chunk, rsa_manifest_chunk_len(manifest, index), digest);
+    return memcmp(digest, manifest->leaves + index * SHA256_DIGEST_SIZE, SHA256_DIGEST_SIZE) == 0;
+}
+
+static void *rsa_manifest_worker(void *arg) {
+    rsa_manifest_worker_t *w = (rsa_manifest_worker_t *)arg;
+    const rsa_manifest_t *m = w->manifest;
+    for (size_t i = w->first; i < w->last && !atomic_load_explicit(w->mismatch, memory_order_relaxed); i++) {
+        if (!rsa_manifest_chunk_matches(m, i, w->image + (size_t)i * m->chunk_size)) {
+            atomic_store(w->mismatch, true);
+        }
+    }
+    return NULL;
+}
+
+void rsa_manifest_leaf_hash(const uint8_t *chunk, size_t len, uint8_t digest[SHA256_DIGEST_SIZE]) {
+    static const uint8_t prefix = RSA_MANIFEST_LEAF_PREFIX;
+    sha256_ctx_t ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, &prefix, 1);
+    sha256_update(&ctx, chunk, len);
+    sha256_final(&ctx, digest);
+}
+
+rsa_verify_result_t rsa_manifest_root(const uint8_t *leaves, size_t count, uint8_t root[SHA256_DIGEST_SIZE]) {
+    if (!leaves || !root || count == 0 || count > SIZE_MAX / SHA256_DIGEST_SIZE) {
+        return RSA_VERIFY_ERROR;
+    }
+    uint8_t *level = malloc(count * SHA256_DIGEST_SIZE);
+    if (!level) return RSA_VERIFY_ERROR;
+    memcpy(level, leaves, count * SHA256_DIGEST_SIZE);
+
+    // Each level is written over the front of the one below it
+    while (count > 1) {
+        size_t next = 0;
+        for (size_t i = 0; i + 1 < count; i += 2, next++) {
+            rsa_manifest_node_hash(level + i * SHA256_DIGEST_SIZE, level + (i + 1) * SHA256_DIGEST_SIZE,
+                                   level + next * SHA256_DIGEST_SIZE);
+        }
+        if (count & 1) {
+            memmove(level + next * SHA256_DIGEST_SIZE, level + (count - 1) * SHA256_DIGEST_SIZE,
+                    SHA256_DIGEST_SIZE);
+            next++;
+        }
+        count = next;
+    }
+    memcpy(root, level, SHA256_DIGEST_SIZE);
+    free(level);
+    return RSA_VERIFY_OK;
+}
+
+rsa_verify_result_t rsa_manifest_parse(rsa_manifest_t *manifest, const uint8_t *data, size_t len) {
+    if (!manifest || !data || len < RSA_MANIFEST_HEADER_SIZE) return RSA_VERIFY_ERROR;
+    if (memcmp(data, RSA_MANIFEST_MAGIC, 4) != 0 || rsa_manifest_be32(data + 4) != RSA_MANIFEST_VERSION) {
+        return RSA_VERIFY_ERROR;
+    }
+
+    uint32_t chunk_size = rsa_manifest_be32(data + 8);
+    uint32_t chunk_count = rsa_manifest_be32(data + 12);
+    uint64_t image_size = rsa_manifest_be64(data + 16);
+    if (chunk_size == 0 || image_size == 0 || image_size > SIZE_MAX ||
+        (image_size - 1) / chunk_size + 1 != chunk_count) {
+        return RSA_VERIFY_ERROR;
+    }
+    size_t leaves_len = len - RSA_MANIFEST_HEADER_SIZE;
+    if (leaves_len % SHA256_DIGEST_SIZE != 0 || leaves_len / SHA256_DIGEST_SIZE != chunk_count) {
+        return RSA_VERIFY_ERROR;
+    }
+
+    manifest->chunk_size = chunk_size;
+    manifest->chunk_count = chunk_count;
+    manifest->image_size = image_size;
+    memcpy(manifest->root, data + 24, SHA256_DIGEST_SIZE);
+    manifest->header = data;
+    manifest->leaves = data + RSA_MANIFEST_HEADER_SIZE;
+    manifest->verified = false;
+    return RSA_VERIFY_OK;
+}
+
+rsa_verify_result_t rsa_manifest_verify(
+    rsa_manifest_t *manifest, const rsa_public_key_t *key,
+    const uint8_t *signature, size_t sig_len
+) {
+    if (!manifest || !manifest->header || !key || !signature) return RSA_VERIFY_ERROR;
+    manifest->verified = false;
+
+    rsa_verify_result_t result = rsa_verify_with_key(key, manifest->header, RSA_MANIFEST_HEADER_SIZE,
+                                                     signature, sig_len);
+    if (result != RSA_VERIFY_OK) return result;
+
+    uint8_t root[SHA256_DIGEST_SIZE];
+    result = rsa_manifest_root(manifest->leaves, manifest->chunk_count, root);
+    if (result != RSA_VERIFY_OK) return result;
+    if (memcmp(root, manifest->root, SHA256_DIGEST_SIZE) != 0) return RSA_VERIFY_MANIFEST_MISMATCH;
+
+    manifest->verified = true;
+    return RSA_VERIFY_OK;
+}
+
+rsa_verify_result_t rsa_manifest_verify_chunk(
+    const rsa_manifest_t *manifest, size_t index,
+    const uint8_t *chunk, size_t len
+) {
+    if (!manifest || !manifest->verified || !chunk || index >= manifest->chunk_count) {
+        return RSA_VERIFY_ERROR;
+    }
+    if (len != rsa_manifest_chunk_len(manifest, index)) return RSA_VERIFY_MANIFEST_MISMATCH;
+    return rsa_manifest_chunk_matches(manifest, index, chunk) ? RSA_VERIFY_OK : RSA_VERIFY_MANIFEST_MISMATCH;
+}
+
+rsa_verify_result_t rsa_manifest_verify_image(
+    const rsa_manifest_t *manifest,
+    const uint8_t *image, size_t size,
+    unsigned threads
+) {
+    if (!manifest || !manifest->verified || !image) return RSA_VERIFY_ERROR;
+    if (size != manifest->image_size) return RSA_VERIFY_MANIFEST_MISMATCH;
+
+    if (threads == 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (unsigned)cpus : 1;
+#else
+        threads = 1;
+#endif
+    }
+    if (threads > RSA_MANIFEST_MAX_THREADS) threads = RSA_MANIFEST_MAX_THREADS;
+    if (threads > manifest->chunk_count) threads = manifest->chunk_count;
+
+    // Contiguous runs of chunks per thread; the calling thread takes the first
+    atomic_bool mismatch;
+    atomic_init(&mismatch, false);
+    rsa_manifest_worker_t workers[RSA_MANIFEST_MAX_THREADS];
+    pthread_t tids[RSA_MANIFEST_MAX_THREADS];
+    bool started[RSA_MANIFEST_MAX_THREADS];
+    for (unsigned t = 0; t < threads; t++) {
+        workers[t].manifest = manifest;
+        workers[t].image = image;
+        workers[t].first = (size_t)manifest->chunk_count * t / threads;
+        workers[t].last = (size_t)manifest->chunk_count * (t + 1) / threads;
+        workers[t].mismatch = &mismatch;
+        started[t] = (t > 0) && pthread_create(&tids[t], NULL, rsa_manifest_worker, &workers[t]) == 0;
+    }
+    for (unsigned t = 0; t < threads; t++) {
+        if (!started[t]) rsa_manifest_worker(&workers[t]);
+    }
+    for (unsigned t = 1; t < threads; t++) {
+        if (started[t]) pthread_join(tids[t], NULL);
+    }
+    return atomic_load(&mismatch) ? RSA_VERIFY_MANIFEST_MISMATCH : RSA_VERIFY_OK;
+}
+
+rsa_verify_result_t verify_firmware_manifest(
+    const uint8_t *firmware_data, size_t firmware_size,
+    const uint8_t *manifest, size_t manifest_len,
+    const uint8_t *signature, size_t sig_len,
+    unsigned threads
+) {
+    const rsa_public_key_t *key = firmware_public_key();
+    rsa_manifest_t parsed;
+    if (!key || rsa_manifest_parse(&parsed, manifest, manifest_len) != RSA_VERIFY_OK) {
+        return RSA_VERIFY_ERROR;
+    }
+    rsa_verify_result_t result = rsa_manifest_verify(&parsed, key, signature, sig_len);
+    if (result != RSA_VERIFY_OK) {
+        return result;
+    }
+    return rsa_manifest_verify_image(&parsed, firmware_data, firmware_size, threads);
+}
@@ -0,0 +1,141 @@
+#ifndef RSA_MANIFEST_H
+#define RSA_MANIFEST_H
+
+#include "rsa2048.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Chunked firmware manifest. The image is split into chunk_size-byte chunks
+ * (the last one may be shorter), each chunk is hashed into a leaf, and the
+ * leaves form a Merkle tree. Only the fixed header, which ends with the tree
+ * root, is signed, so the chunks can be hashed in parallel and any single
+ * chunk can be checked on its own once the manifest is verified.
+ *
+ * Layout (integers big-endian):
+ *   0  magic "FWMF"
+ *   4  version (1)
+ *   8  chunk size in bytes
+ *  12  chunk count (ceil(image size / chunk size))
+ *  16  image size in bytes (64-bit)
+ *  24  Merkle root
+ *  56  leaf digests, chunk count x 32 bytes (not signed, bound by the root)
+ *
+ * leaf = SHA-256(0x00 || chunk), node = SHA-256(0x01 || left || right); a
+ * node left without a partner moves up to the next level unchanged.
+ */
+#define RSA_MANIFEST_MAGIC       "FWMF"
+#define RSA_MANIFEST_VERSION     1
+#define RSA_MANIFEST_HEADER_SIZE (24 + SHA256_DIGEST_SIZE)   // signed part
+
+typedef struct {
+    uint32_t chunk_size;
+    uint32_t chunk_count;
+    uint64_t image_size;
+    uint8_t root[SHA256_DIGEST_SIZE];
+    const uint8_t *header;       // RSA_MANIFEST_HEADER_SIZE signed bytes (caller's buffer)
+    const uint8_t *leaves;       // chunk_count leaf digests (caller's buffer)
+    bool verified;               // signature and leaves checked by rsa_manifest_verify
+} rsa_manifest_t;
+
+/**
+ * Compute the leaf digest of one chunk
+ *
+ * @param chunk: Chunk data
+ * @param len: Chunk length
+ * @param digest: Receives the leaf digest
+ */
+void rsa_manifest_leaf_hash(const uint8_t *chunk, size_t len, uint8_t digest[SHA256_DIGEST_SIZE]);
+
+/**
+ * Compute the Merkle root of a list of leaf digests
+ *
+ * @param leaves: count leaf digests, back to back
+ * @param count: Number of leaves (at least 1)
+ * @param root: Receives the root
+ * @return RSA_VERIFY_OK on success, RSA_VERIFY_ERROR on bad input or allocation failure
+ */
+rsa_verify_result_t rsa_manifest_root(const uint8_t *leaves, size_t count, uint8_t root[SHA256_DIGEST_SIZE]);
+
+/**
+ * Parse a manifest. The manifest keeps pointers into data, which must stay
+ * valid while it is used.
+ *
+ * @param manifest: Receives the parsed manifest (not verified yet)
+ * @param data: Manifest file contents
+ * @param len: Manifest length in bytes
+ * @return RSA_VERIFY_OK on success, RSA_VERIFY_ERROR if malformed
+ */
+rsa_verify_result_t rsa_manifest_parse(rsa_manifest_t *manifest, const uint8_t *data, size_t len);
+
+/**
+ * Verify the manifest signature (PKCS#1 v1.5, SHA-256, over the header) and
+ * that the leaf digests hash to the signed root
+ *
+ * @param manifest: Parsed manifest, marked verified on success
+ * @param key: Signer's public key
+ * @param signature: RSA signature bytes (big-endian)
+ * @param sig_len: Signature length (should be the modulus size)
+ * @return RSA_VERIFY_OK if valid, RSA_VERIFY_MANIFEST_MISMATCH if the leaves
+ *         do not match the root, error code otherwise
+ */
+rsa_verify_result_t rsa_manifest_verify(
+    rsa_manifest_t *manifest, const rsa_public_key_t *key,
+    const uint8_t *signature, size_t sig_len
+);
+
+/**
+ * Check one chunk against a verified manifest
+ *
+ * @param manifest: Verified manifest
+ * @param index: Chunk index
+ * @param chunk: Chunk data
+ * @param len: Chunk length (chunk_size, or the remainder for the last chunk)
+ * @return RSA_VERIFY_OK if the chunk matches, RSA_VERIFY_MANIFEST_MISMATCH if
+ *         not, RSA_VERIFY_ERROR on bad arguments or an unverified manifest
+ */
+rsa_verify_result_t rsa_manifest_verify_chunk(
+    const rsa_manifest_t *manifest, size_t index,
+    const uint8_t *chunk, size_t len
+);
+
+/**
+ * Check a whole image against a verified manifest, hashing the chunks on
+ * several threads
+ *
+ * @param manifest: Verified manifest
+ * @param image: Image data
+ * @param size: Image size (must equal the manifest's image size)
+ * @param threads: Hashing threads (0: one per online CPU)
+ * @return RSA_VERIFY_OK if every chunk matches, RSA_VERIFY_MANIFEST_MISMATCH if
+ *         not, RSA_VERIFY_ERROR on bad arguments or an unverified manifest
+ */
+rsa_verify_result_t rsa_manifest_verify_image(
+    const rsa_manifest_t *manifest,
+    const uint8_t *image, size_t size,
+    unsigned threads
+);
+
+/**
+ * Verify a firmware image against a chunked manifest signed with the
+ * embedded key (firmware_public_key): checks the manifest signature, then
+ * hashes the image's chunks on several threads
+ *
+ * @param firmware_data: Firmware image
+ * @param firmware_size: Image size in bytes
+ * @param manifest: Manifest file contents (make_manifest.py)
+ * @param manifest_len: Manifest length in bytes
+ * @param signature: Manifest signature (RSA_KEY_SIZE bytes)
+ * @param sig_len: Signature length
+ * @param threads: Hashing threads (0: one per online CPU)
+ * @return RSA_VERIFY_OK if the image matches the signed manifest, error code otherwise
+ */
+rsa_verify_result_t verify_firmware_manifest(
+    const uint8_t *firmware_data, size_t firmware_size,
+    const uint8_t *manifest, size_t manifest_len,
+    const uint8_t *signature, size_t sig_len,
+    unsigned threads
+);
+
+#endif // RSA_MANIFEST_H
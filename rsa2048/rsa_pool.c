@@ -0,0 +1,206 @@
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+#include "rsa_pool.h"
+
+#define RSA_POOL_CACHE_LINE 64
+// Jobs handed to the workers at once; a range holds two 32-bit indices
+#define RSA_POOL_SEGMENT ((size_t)UINT32_MAX)
+
+// Each worker's range is next (low 32 bits) and end (high 32 bits) of its
+// jobs, on a cache line of its own. The owner takes jobs from the front and
+// thieves cut off the back, both with a compare-and-swap on the whole range.
+struct rsa_pool_worker {
+    _Alignas(RSA_POOL_CACHE_LINE) _Atomic uint64_t range;
+    rsa_verify_pool_t *pool;
+    unsigned index;
+    pthread_t tid;
+};
+
+static uint64_t rsa_pool_range(size_t next, size_t end) {
+    return ((uint64_t)end << 32) | (uint64_t)next;
+}
+
+// Takes the next job of the worker's own range
+static bool rsa_pool_take(rsa_pool_worker_t *self, size_t *job) {
+    uint64_t range = atomic_load_explicit(&self->range, memory_order_relaxed);
+    for (;;) {
+        size_t next = (uint32_t)range, end = (size_t)(range >> 32);
+        if (next >= end) return false;
+        if (atomic_compare_exchange_weak(&self->range, &range, rsa_pool_range(next + 1, end))) {
+            *job = next;
+            return true;
+        }
+    }
+}
+
+// Moves the back half of another worker's jobs to the (empty) own range
+static bool rsa_pool_steal(rsa_pool_worker_t *self) {
+    rsa_verify_pool_t *pool = self->pool;
+    for (unsigned k = 1; k < pool->threads; k++) {
+        rsa_pool_worker_t *victim = &pool->workers[(self->index + k) % pool->threads];
+        uint64_t range = atomic_load_explicit(&victim->range, memory_order_relaxed);
+        for (;;) {
+            size_t next = (uint32_t)range, end = (size_t)(range >> 32);
+            if (next >= end) break;
+            size_t mid = end - (end - next + 1) / 2;
+            if (atomic_compare_exchange_weak(&victim->range, &range, rsa_pool_range(next, mid))) {
+                atomic_store(&self->range, rsa_pool_range(mid, end));
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// One worker's part of the posted batch, until no range has jobs left
+static void rsa_pool_run(rsa_pool_worker_t *self, void *workspace, size_t workspace_size) {
+    const rsa_verify_job_t *jobs = self->pool->jobs;
+    rsa_verify_result_t *results = self->pool->results;
+    do {
+        size_t i;
+        while (rsa_pool_take(self, &i)) {
+            const rsa_verify_job_t *job = &jobs[i];
+            results[i] = rsa_verify_with_key_ws(job->key, job->message, job->message_len,
+                                                job->signature, job->sig_len,
+                                                workspace, workspace_size);
+        }
+    } while (rsa_pool_steal(self));
+}
+
+static void *rsa_pool_thread(void *arg) {
+    rsa_pool_worker_t *self = (rsa_pool_worker_t *)arg;
+    rsa_verify_pool_t *pool = self->pool;
+    _Alignas(RSA_WORKSPACE_ALIGN) uint8_t workspace[RSA_VERIFY_WORKSPACE_MAX];
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->stop && pool->generation == seen) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stop) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        rsa_pool_run(self, workspace, sizeof(workspace));
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->running == 0) pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+rsa_verify_result_t rsa_verify_pool_init(rsa_verify_pool_t *pool, unsigned threads) {
+    if (!pool) return RSA_VERIFY_ERROR;
+    if (threads == 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (unsigned)cpus : 1;
+#else
+        threads = 1;
+#endif
+    }
+    if (threads > RSA_POOL_MAX_THREADS) threads = RSA_POOL_MAX_THREADS;
+
+    memset(pool, 0, sizeof(*pool));
+    pool->workers_mem = malloc(threads * sizeof(rsa_pool_worker_t) + RSA_POOL_CACHE_LINE - 1);
+    if (!pool->workers_mem) return RSA_VERIFY_ERROR;
+    pool->workers = (rsa_pool_worker_t *)(((uintptr_t)pool->workers_mem + RSA_POOL_CACHE_LINE - 1) &
+                                          ~(uintptr_t)(RSA_POOL_CACHE_LINE - 1));
+    if (pthread_mutex_init(&pool->lock, NULL) != 0) {
+        free(pool->workers_mem);
+        return RSA_VERIFY_ERROR;
+    }
+    pthread_mutex_init(&pool->batch_lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    for (unsigned t = 0; t < threads; t++) {
+        atomic_init(&pool->workers[t].range, 0);
+        pool->workers[t].pool = pool;
+        pool->workers[t].index = t;
+    }
+    // Worker 0 is the caller of rsa_verify_batch; a pool keeps the threads it got
+    pool->threads = 1;
+    while (pool->threads < threads &&
+           pthread_create(&pool->workers[pool->threads].tid, NULL, rsa_pool_thread,
+                          &pool->workers[pool->threads]) == 0) {
+        pool->threads++;
+    }
+    return RSA_VERIFY_OK;
+}
+
+void rsa_verify_pool_free(rsa_verify_pool_t *pool) {
+    if (!pool || !pool->workers) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (unsigned t = 1; t < pool->threads; t++) {
+        pthread_join(pool->workers[t].tid, NULL);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->batch_lock);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers_mem);
+    pool->workers = NULL;
+}
+
+rsa_verify_result_t rsa_verify_batch(
+    rsa_verify_pool_t *pool,
+    const rsa_verify_job_t *jobs, rsa_verify_result_t *results, size_t count
+) {
+    _Alignas(RSA_WORKSPACE_ALIGN) uint8_t workspace[RSA_VERIFY_WORKSPACE_MAX];
+    if (!jobs || !results) {
+        return RSA_VERIFY_ERROR;
+    }
+
+    if (!pool || !pool->workers) {
+        for (size_t i = 0; i < count; i++) {
+            results[i] = rsa_verify_with_key_ws(jobs[i].key, jobs[i].message, jobs[i].message_len,
+                                                jobs[i].signature, jobs[i].sig_len,
+                                                workspace, sizeof(workspace));
+        }
+    } else {
+        pthread_mutex_lock(&pool->batch_lock);
+        for (size_t base = 0; base < count; base += RSA_POOL_SEGMENT) {
+            size_t n = (count - base < RSA_POOL_SEGMENT) ? count - base : RSA_POOL_SEGMENT;
+            unsigned threads = pool->threads;
+
+            // Even contiguous ranges to start with; stealing evens out the rest
+            for (unsigned t = 0; t < threads; t++) {
+                atomic_store(&pool->workers[t].range,
+                             rsa_pool_range((size_t)((uint64_t)n * t / threads),
+                                            (size_t)((uint64_t)n * (t + 1) / threads)));
+            }
+            pthread_mutex_lock(&pool->lock);
+            pool->jobs = jobs + base;
+            pool->results = results + base;
+            pool->running = threads - 1;
+            pool->generation++;
+            pthread_cond_broadcast(&pool->wake);
+            pthread_mutex_unlock(&pool->lock);
+
+            rsa_pool_run(&pool->workers[0], workspace, sizeof(workspace));
+
+            pthread_mutex_lock(&pool->lock);
+            while (pool->running > 0) {
+                pthread_cond_wait(&pool->done, &pool->lock);
+            }
+            pthread_mutex_unlock(&pool->lock);
+        }
+        pthread_mutex_unlock(&pool->batch_lock);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (results[i] != RSA_VERIFY_OK) return results[i];
+    }
+    return RSA_VERIFY_OK;
+}
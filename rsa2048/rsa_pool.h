@@ -0,0 +1,76 @@
+#ifndef RSA_POOL_H
+#define RSA_POOL_H
+
+#include "rsa2048.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Most threads of a pool, the calling thread included
+#define RSA_POOL_MAX_THREADS 256
+
+// One independent verification of rsa_verify_batch
+typedef struct {
+    const rsa_public_key_t *key;    // signer's key (rsa_public_key_init, or from a keyring)
+    const uint8_t *message;
+    size_t message_len;
+    const uint8_t *signature;       // big-endian
+    size_t sig_len;
+} rsa_verify_job_t;
+
+typedef struct rsa_pool_worker rsa_pool_worker_t;
+
+// Worker threads kept across rsa_verify_batch calls. Each worker owns a range
+// of the batch and takes jobs from its front; a worker whose range runs dry
+// steals the back half of another one's. Workers verify with their own
+// workspace, so apart from the ranges they share nothing.
+typedef struct {
+    rsa_pool_worker_t *workers;     // threads entries, aligned to cache lines
+    void *workers_mem;              // allocation behind workers
+    unsigned threads;               // workers; worker 0 is the thread calling rsa_verify_batch
+    pthread_mutex_t lock;           // guards the fields below
+    pthread_cond_t wake;            // a batch was posted, or the pool stops
+    pthread_cond_t done;            // the last worker finished the batch
+    pthread_mutex_t batch_lock;     // one batch at a time
+    const rsa_verify_job_t *jobs;
+    rsa_verify_result_t *results;
+    uint64_t generation;            // batches posted so far
+    unsigned running;               // pool threads still on the current batch
+    bool stop;
+} rsa_verify_pool_t;
+
+/**
+ * Start a verification thread pool
+ *
+ * @param pool: Pool to initialize
+ * @param threads: Workers, the calling thread included (0: one per online CPU,
+ *                 at most RSA_POOL_MAX_THREADS)
+ * @return RSA_VERIFY_OK on success, RSA_VERIFY_ERROR otherwise
+ */
+rsa_verify_result_t rsa_verify_pool_init(rsa_verify_pool_t *pool, unsigned threads);
+
+/**
+ * Stop the pool's threads and release it. No batch may be running.
+ *
+ * @param pool: Pool to destroy
+ */
+void rsa_verify_pool_free(rsa_verify_pool_t *pool);
+
+/**
+ * Verify independent (key, message, signature) jobs on all workers of a pool.
+ * Each job gets the result rsa_verify_with_key would give it. Calls on the
+ * same pool from several threads run one after the other.
+ *
+ * @param pool: Pool from rsa_verify_pool_init (NULL: the calling thread alone)
+ * @param jobs: Jobs to verify
+ * @param results: Receives one result per job
+ * @param count: Number of jobs
+ * @return RSA_VERIFY_OK if every signature is valid, otherwise the first failing job's result
+ */
+rsa_verify_result_t rsa_verify_batch(
+    rsa_verify_pool_t *pool,
+    const rsa_verify_job_t *jobs, rsa_verify_result_t *results, size_t count
+);
+
+#endif // RSA_POOL_H
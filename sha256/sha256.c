@@ -2,6 +2,19 @@
 // ========== SHA256.C ==========
 #include "sha256.h"
 #include <string.h>
+#include <stdbool.h>
+#if SHA256_SHANI || SHA256_MULTI_BUFFER
+#include <immintrin.h>
+#endif
+#if SHA256_SHANI
+#include <stdatomic.h>
+#include <cpuid.h>
+#ifndef bit_SHA
+#define bit_SHA (1 << 29)
+#endif
+#endif
+
+#define SHA256_CHECKPOINT_MAGIC "S256"
 
 // SHA-256 constants
 static const uint32_t K[64] = {
@@ -24,57 +37,458 @@ static const uint32_t K[64] = {
 };
 
 #define ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
-#define CH(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
-#define MAJ(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define CH(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
 #define SIGMA0(x) (ROTR(x, 2) ^ ROTR(x, 13) ^ ROTR(x, 22))
 #define SIGMA1(x) (ROTR(x, 6) ^ ROTR(x, 11) ^ ROTR(x, 25))
 #define GAMMA0(x) (ROTR(x, 7) ^ ROTR(x, 18) ^ ((x) >> 3))
 #define GAMMA1(x) (ROTR(x, 17) ^ ROTR(x, 19) ^ ((x) >> 10))
 
-static uint32_t be32_to_cpu(const uint8_t *p) {
+// Big-endian word at p (any alignment): one load and a byte swap on
+// GCC/Clang little-endian targets
+static inline uint32_t be32_to_cpu(const uint8_t *p) {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__BYTE_ORDER__)
+    uint32_t val;
+    memcpy(&val, p, 4);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    val = __builtin_bswap32(val);
+#endif
+    return val;
+#else
     return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | 
            ((uint32_t)p[2] << 8) | p[3];
+#endif
 }
 
-static void cpu_to_be32(uint8_t *p, uint32_t val) {
+static inline void cpu_to_be32(uint8_t *p, uint32_t val) {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__BYTE_ORDER__)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    val = __builtin_bswap32(val);
+#endif
+    memcpy(p, &val, 4);
+#else
     p[0] = (val >> 24) & 0xff;
     p[1] = (val >> 16) & 0xff;
     p[2] = (val >> 8) & 0xff;
     p[3] = val & 0xff;
+#endif
 }
 
-static void sha256_transform(uint32_t state[8], const uint8_t block[SHA256_BLOCK_SIZE]) {
-    uint32_t W[64];
-    uint32_t a, b, c, d, e, f, g, h;
-    uint32_t T1, T2;
-    int i;
+/*
+ * One round. The working variables are renamed rather than moved: each call
+ * passes them rotated by one position, so a round only writes d (the next e)
+ * and h (the next a), and after eight rounds the names line up again.
+ */
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, i, w) do {          \
+        uint32_t t1 = (h) + SIGMA1(e) + CH(e, f, g) + K[i] + (w); \
+        (d) += t1;                                              \
+        (h) = t1 + SIGMA0(a) + MAJ(a, b, c);                    \
+    } while (0)
+
+// Message word i: loaded (i < 16), or extended in the rolling 16-word window
+#define SHA256_W(i) (W[i])
+#define SHA256_W_NEXT(i) \
+    (W[(i) & 15] += GAMMA1(W[((i) - 2) & 15]) + W[((i) - 7) & 15] + GAMMA0(W[((i) - 15) & 15]))
+
+#define SHA256_ROUNDS8(i, w)                                    \
+    SHA256_ROUND(a, b, c, d, e, f, g, h, (i) + 0, w((i) + 0));  \
+    SHA256_ROUND(h, a, b, c, d, e, f, g, (i) + 1, w((i) + 1));  \
+    SHA256_ROUND(g, h, a, b, c, d, e, f, (i) + 2, w((i) + 2));  \
+    SHA256_ROUND(f, g, h, a, b, c, d, e, (i) + 3, w((i) + 3));  \
+    SHA256_ROUND(e, f, g, h, a, b, c, d, (i) + 4, w((i) + 4));  \
+    SHA256_ROUND(d, e, f, g, h, a, b, c, (i) + 5, w((i) + 5));  \
+    SHA256_ROUND(c, d, e, f, g, h, a, b, (i) + 6, w((i) + 6));  \
+    SHA256_ROUND(b, c, d, e, f, g, h, a, (i) + 7, w((i) + 7))
+
+// Block function with fully unrolled rounds and a 16-word message schedule
+static void sha256_transform_portable(uint32_t state[8], const uint8_t *block, size_t blocks) {
+    uint32_t W[16];
+
+    for (; blocks > 0; blocks--, block += SHA256_BLOCK_SIZE) {
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int i = 0; i < 16; i++) {
+            W[i] = be32_to_cpu(block + i * 4);
+        }
+
+#if defined(__OPTIMIZE_SIZE__)
+        // -Os: one 8-round group in a loop, about a sixth of the unrolled code
+        for (int i = 0; i < 16; i += 8) {
+            SHA256_ROUNDS8(i, SHA256_W);
+        }
+        for (int i = 16; i < 64; i += 8) {
+            SHA256_ROUNDS8(i, SHA256_W_NEXT);
+        }
+#else
+        SHA256_ROUNDS8(0, SHA256_W);
+        SHA256_ROUNDS8(8, SHA256_W);
+        SHA256_ROUNDS8(16, SHA256_W_NEXT);
+        SHA256_ROUNDS8(24, SHA256_W_NEXT);
+        SHA256_ROUNDS8(32, SHA256_W_NEXT);
+        SHA256_ROUNDS8(40, SHA256_W_NEXT);
+        SHA256_ROUNDS8(48, SHA256_W_NEXT);
+        SHA256_ROUNDS8(56, SHA256_W_NEXT);
+#endif
 
-    // Prepare message schedule
-    for (i = 0; i < 16; i++) {
-        W[i] = be32_to_cpu(block + i * 4);
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
     }
-    
-    for (i = 16; i < 64; i++) {
-        W[i] = GAMMA1(W[i-2]) + W[i-7] + GAMMA0(W[i-15]) + W[i-16];
+}
+
+#if SHA256_SHANI
+#define SHA256_SHANI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+
+/*
+ * Block function on the SHA extensions. The state is kept as ABEF/CDGH
+ * vectors, the layout sha256rnds2 works on; each sha256rnds2 runs two rounds,
+ * and sha256msg1/sha256msg2 extend the message schedule four words at a time.
+ */
+SHA256_SHANI_TARGET
+static void sha256_transform_shani(uint32_t state[8], const uint8_t *block, size_t blocks) {
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xB1);    // CDAB
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1B); // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);                                     // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);                                          // CDGH
+
+    for (; blocks > 0; blocks--, block += SHA256_BLOCK_SIZE) {
+        __m128i abef = state0, cdgh = state1;
+        __m128i msg[4];
+        for (int i = 0; i < 4; i++) {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 16 * i)), bswap);
+        }
+
+        // 16 groups of four rounds; group r + 4 of the schedule is built while
+        // group r is consumed, reusing its slot
+#if defined(__clang__)
+#pragma clang loop unroll(full)
+#elif defined(__GNUC__)
+#pragma GCC unroll 16
+#endif
+        for (int r = 0; r < 16; r++) {
+            __m128i wk = _mm_add_epi32(msg[r & 3], _mm_loadu_si128((const __m128i *)&K[4 * r]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));
+            if (r < 12) {
+                __m128i w = _mm_sha256msg1_epu32(msg[r & 3], msg[(r + 1) & 3]);
+                w = _mm_add_epi32(w, _mm_alignr_epi8(msg[(r + 3) & 3], msg[(r + 2) & 3], 4));
+                msg[r & 3] = _mm_sha256msg2_epu32(w, msg[(r + 3) & 3]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);                          // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);                       // DCHG
+    _mm_storeu_si128((__m128i *)&state[0], _mm_blend_epi16(tmp, state1, 0xF0));  // DCBA
+    _mm_storeu_si128((__m128i *)&state[4], _mm_alignr_epi8(state1, tmp, 8));     // HGFE
+}
+
+// CPUID: SHA (leaf 7, EBX bit 29) plus the SSSE3/SSE4.1 shuffles used around it
+static int sha256_shani_supported(void) {
+    static atomic_int supported = -1;
+    int s = atomic_load_explicit(&supported, memory_order_relaxed);
+    if (s < 0) {
+        unsigned int eax, ebx, ecx, edx;
+        s = __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+            (ecx & bit_SSSE3) && (ecx & bit_SSE4_1) &&
+            __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+            (ebx & bit_SHA);
+        atomic_store_explicit(&supported, s, memory_order_relaxed);
+    }
+    return s;
+}
+#endif
+
+// Processes `blocks` consecutive 64-byte blocks
+static void sha256_transform(uint32_t state[8], const uint8_t *block, size_t blocks) {
+#if SHA256_SHANI
+    if (sha256_shani_supported()) {
+        sha256_transform_shani(state, block, blocks);
+        return;
+    }
+#endif
+    sha256_transform_portable(state, block, blocks);
+}
+
+// ---------------------------------------------------------------------------
+// Multi-buffer hashing
+//
+// Each lane of a vector register carries its own stream: the kernels run one
+// block of every lane per call, on states kept transposed (word j of lane l
+// at state[j * lanes + l]). A lane whose message is done is refilled with the
+// next one; once the queue is empty and few lanes are left, those finish on
+// the single-stream block function.
+// ---------------------------------------------------------------------------
+
+#if SHA256_MULTI_BUFFER
+static const uint32_t sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+typedef struct {
+    const uint8_t *data;                    // next block, in the message or in tail
+    size_t full_blocks;                     // full message blocks left
+    size_t tail_blocks;                     // padded final blocks left after those (1 or 2)
+    size_t index;                           // message being hashed
+    uint8_t tail[2 * SHA256_BLOCK_SIZE];    // message end, padding and length
+} sha256_lane_t;
+
+// Builds the padded final block(s) of a message, returns their count
+static size_t sha256_pad_tail(uint8_t tail[2 * SHA256_BLOCK_SIZE], const uint8_t *data, size_t len) {
+    size_t rem = len % SHA256_BLOCK_SIZE;
+    size_t blocks = (rem < 56) ? 1 : 2;
+    uint64_t bit_len = (uint64_t)len * 8;
+
+    memset(tail, 0, blocks * SHA256_BLOCK_SIZE);
+    if (rem) memcpy(tail, data + len - rem, rem);
+    tail[rem] = 0x80;
+    for (int i = 0; i < 8; i++) {
+        tail[blocks * SHA256_BLOCK_SIZE - 1 - i] = (bit_len >> (i * 8)) & 0xff;
     }
+    return blocks;
+}
 
-    // Initialize working variables
-    a = state[0]; b = state[1]; c = state[2]; d = state[3];
-    e = state[4]; f = state[5]; g = state[6]; h = state[7];
+static void sha256_lane_start(sha256_lane_t *lane, uint32_t *state, size_t lanes, size_t l,
+                              const uint8_t *data, size_t len, size_t index) {
+    lane->full_blocks = len / SHA256_BLOCK_SIZE;
+    lane->tail_blocks = sha256_pad_tail(lane->tail, data, len);
+    lane->data = lane->full_blocks ? data : lane->tail;
+    lane->index = index;
+    for (int j = 0; j < 8; j++) {
+        state[j * lanes + l] = sha256_iv[j];
+    }
+}
 
-    // Main loop
-    for (i = 0; i < 64; i++) {
-        T1 = h + SIGMA1(e) + CH(e, f, g) + K[i] + W[i];
-        T2 = SIGMA0(a) + MAJ(a, b, c);
-        h = g; g = f; f = e; e = d + T1;
-        d = c; c = b; b = a; a = T1 + T2;
+// Takes the lane's next block
+static const uint8_t *sha256_lane_next(sha256_lane_t *lane) {
+    const uint8_t *block = lane->data;
+    if (lane->full_blocks) {
+        lane->full_blocks--;
+        lane->data = lane->full_blocks ? block + SHA256_BLOCK_SIZE : lane->tail;
+    } else {
+        lane->tail_blocks--;
+        lane->data = block + SHA256_BLOCK_SIZE;
     }
+    return block;
+}
+
+#define SHA256_AVX2_TARGET __attribute__((target("avx2")))
+#define SHA256_AVX512_TARGET __attribute__((target("avx512f,avx2")))
+
+// Runs one block of each lane; idle lanes get a dummy block
+typedef void (*sha256_mb_fn)(uint32_t *state, const uint8_t *const block[]);
 
-    // Update state
-    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
-    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+/*
+ * Loads 32 bytes at `offset` of eight lanes' blocks as eight vectors, vector
+ * t holding word t of every lane (an 8x8 transpose), byte-swapped.
+ */
+SHA256_AVX2_TARGET
+static void sha256_mb_load8(__m256i w[8], const uint8_t *const block[], size_t offset) {
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    __m256i r[8], t[8], u[8];
+    for (int l = 0; l < 8; l++) {
+        r[l] = _mm256_loadu_si256((const __m256i *)(block[l] + offset));
+    }
+    for (int l = 0; l < 8; l += 2) {
+        t[l] = _mm256_unpacklo_epi32(r[l], r[l + 1]);
+        t[l + 1] = _mm256_unpackhi_epi32(r[l], r[l + 1]);
+    }
+    for (int l = 0; l < 8; l += 4) {
+        u[l] = _mm256_unpacklo_epi64(t[l], t[l + 2]);
+        u[l + 1] = _mm256_unpackhi_epi64(t[l], t[l + 2]);
+        u[l + 2] = _mm256_unpacklo_epi64(t[l + 1], t[l + 3]);
+        u[l + 3] = _mm256_unpackhi_epi64(t[l + 1], t[l + 3]);
+    }
+    for (int j = 0; j < 4; j++) {
+        w[j] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u[j], u[j + 4], 0x20), bswap);
+        w[j + 4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u[j], u[j + 4], 0x31), bswap);
+    }
+}
+
+#define SHA256_ROR8(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#define SHA256_XOR8(x, y, z) _mm256_xor_si256(_mm256_xor_si256(x, y), z)
+
+// Eight streams in AVX2 lanes
+SHA256_AVX2_TARGET
+static void sha256_mb_avx2(uint32_t *state, const uint8_t *const block[]) {
+    __m256i w[16], s[8];
+    sha256_mb_load8(w, block, 0);
+    sha256_mb_load8(w + 8, block, 32);
+    for (int j = 0; j < 8; j++) {
+        s[j] = _mm256_loadu_si256((const __m256i *)(state + 8 * j));
+    }
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+
+    for (int i = 0; i < 64; i++) {
+        if (i >= 16) {
+            __m256i w15 = w[(i - 15) & 15], w2 = w[(i - 2) & 15];
+            __m256i g0 = SHA256_XOR8(SHA256_ROR8(w15, 7), SHA256_ROR8(w15, 18), _mm256_srli_epi32(w15, 3));
+            __m256i g1 = SHA256_XOR8(SHA256_ROR8(w2, 17), SHA256_ROR8(w2, 19), _mm256_srli_epi32(w2, 10));
+            w[i & 15] = _mm256_add_epi32(_mm256_add_epi32(w[i & 15], g0),
+                                         _mm256_add_epi32(w[(i - 7) & 15], g1));
+        }
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i maj = _mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_xor_si256(a, b)));
+        __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, SHA256_XOR8(SHA256_ROR8(e, 6), SHA256_ROR8(e, 11), SHA256_ROR8(e, 25))),
+                                      _mm256_add_epi32(ch, _mm256_add_epi32(_mm256_set1_epi32((int)K[i]), w[i & 15])));
+        __m256i t2 = _mm256_add_epi32(SHA256_XOR8(SHA256_ROR8(a, 2), SHA256_ROR8(a, 13), SHA256_ROR8(a, 22)), maj);
+        h = g; g = f; f = e; e = _mm256_add_epi32(d, t1);
+        d = c; c = b; b = a; a = _mm256_add_epi32(t1, t2);
+    }
+
+    s[0] = _mm256_add_epi32(s[0], a); s[1] = _mm256_add_epi32(s[1], b);
+    s[2] = _mm256_add_epi32(s[2], c); s[3] = _mm256_add_epi32(s[3], d);
+    s[4] = _mm256_add_epi32(s[4], e); s[5] = _mm256_add_epi32(s[5], f);
+    s[6] = _mm256_add_epi32(s[6], g); s[7] = _mm256_add_epi32(s[7], h);
+    for (int j = 0; j < 8; j++) {
+        _mm256_storeu_si256((__m256i *)(state + 8 * j), s[j]);
+    }
 }
 
+#define SHA256_ROR16(x, n) _mm512_ror_epi32(x, n)
+#define SHA256_XOR16(x, y, z) _mm512_ternarylogic_epi32(x, y, z, 0x96)
+
+// Sixteen streams in AVX-512 lanes (vprord and vpternlogd for the round functions)
+SHA256_AVX512_TARGET
+static void sha256_mb_avx512(uint32_t *state, const uint8_t *const block[]) {
+    __m512i w[16], s[8];
+    __m256i lo[16], hi[16];
+    sha256_mb_load8(lo, block, 0);
+    sha256_mb_load8(lo + 8, block, 32);
+    sha256_mb_load8(hi, block + 8, 0);
+    sha256_mb_load8(hi + 8, block + 8, 32);
+    for (int t = 0; t < 16; t++) {
+        w[t] = _mm512_inserti64x4(_mm512_castsi256_si512(lo[t]), hi[t], 1);
+    }
+    for (int j = 0; j < 8; j++) {
+        s[j] = _mm512_loadu_si512((const void *)(state + 16 * j));
+    }
+    __m512i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+
+    for (int i = 0; i < 64; i++) {
+        if (i >= 16) {
+            __m512i w15 = w[(i - 15) & 15], w2 = w[(i - 2) & 15];
+            __m512i g0 = SHA256_XOR16(SHA256_ROR16(w15, 7), SHA256_ROR16(w15, 18), _mm512_srli_epi32(w15, 3));
+            __m512i g1 = SHA256_XOR16(SHA256_ROR16(w2, 17), SHA256_ROR16(w2, 19), _mm512_srli_epi32(w2, 10));
+            w[i & 15] = _mm512_add_epi32(_mm512_add_epi32(w[i & 15], g0),
+                                         _mm512_add_epi32(w[(i - 7) & 15], g1));
+        }
+        __m512i ch = _mm512_ternarylogic_epi32(e, f, g, 0xCA);     // e ? f : g
+        __m512i maj = _mm512_ternarylogic_epi32(a, b, c, 0xE8);    // majority
+        __m512i t1 = _mm512_add_epi32(_mm512_add_epi32(h, SHA256_XOR16(SHA256_ROR16(e, 6), SHA256_ROR16(e, 11), SHA256_ROR16(e, 25))),
+                                      _mm512_add_epi32(ch, _mm512_add_epi32(_mm512_set1_epi32((int)K[i]), w[i & 15])));
+        __m512i t2 = _mm512_add_epi32(SHA256_XOR16(SHA256_ROR16(a, 2), SHA256_ROR16(a, 13), SHA256_ROR16(a, 22)), maj);
+        h = g; g = f; f = e; e = _mm512_add_epi32(d, t1);
+        d = c; c = b; b = a; a = _mm512_add_epi32(t1, t2);
+    }
+
+    s[0] = _mm512_add_epi32(s[0], a); s[1] = _mm512_add_epi32(s[1], b);
+    s[2] = _mm512_add_epi32(s[2], c); s[3] = _mm512_add_epi32(s[3], d);
+    s[4] = _mm512_add_epi32(s[4], e); s[5] = _mm512_add_epi32(s[5], f);
+    s[6] = _mm512_add_epi32(s[6], g); s[7] = _mm512_add_epi32(s[7], h);
+    for (int j = 0; j < 8; j++) {
+        _mm512_storeu_si512((void *)(state + 16 * j), s[j]);
+    }
+}
+
+/*
+ * Multi-buffer kernel worth using on this CPU, NULL if none. A single SHA-NI
+ * stream outruns eight AVX2 lanes and about eight AVX-512 ones, so with SHA-NI
+ * only AVX-512 is used, and lanes are drained to it sooner.
+ */
+static sha256_mb_fn sha256_mb_kernel(size_t *lanes, size_t *drain) {
+    bool shani = false;
+#if SHA256_SHANI
+    shani = sha256_shani_supported();
+#endif
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        *lanes = 16;
+        *drain = shani ? 8 : 2;
+        return sha256_mb_avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && !shani) {
+        *lanes = 8;
+        *drain = 2;
+        return sha256_mb_avx2;
+    }
+    return NULL;
+}
+
+// Finishes a lane on the single-stream block function
+static void sha256_lane_finish(sha256_lane_t *lane, const uint32_t *state, size_t lanes, size_t l,
+                               uint8_t digest[SHA256_DIGEST_SIZE]) {
+    uint32_t st[8];
+    for (int j = 0; j < 8; j++) {
+        st[j] = state[j * lanes + l];
+    }
+    const uint8_t *data = lane->data;
+    if (lane->full_blocks) {
+        sha256_transform(st, data, lane->full_blocks);
+        data = lane->tail;
+    }
+    sha256_transform(st, data, lane->tail_blocks);
+    for (int j = 0; j < 8; j++) {
+        cpu_to_be32(digest + j * 4, st[j]);
+    }
+}
+
+/*
+ * Runs the messages through `lanes` streams of the kernel until the queue is
+ * empty and at most `drain` lanes are still busy; those finish one by one.
+ */
+static void sha256_hash_lanes(sha256_mb_fn kernel, size_t lanes, size_t drain,
+                              const uint8_t *const messages[], const size_t lens[],
+                              uint8_t digests[][SHA256_DIGEST_SIZE], size_t count) {
+    static const uint8_t idle_block[SHA256_BLOCK_SIZE];
+    _Alignas(64) uint32_t state[8 * SHA256_MB_MAX_LANES];
+    sha256_lane_t lane[SHA256_MB_MAX_LANES];
+    const uint8_t *block[SHA256_MB_MAX_LANES];
+    bool busy[SHA256_MB_MAX_LANES];
+    size_t next = 0, active = 0;
+
+    for (size_t l = 0; l < lanes; l++) {
+        busy[l] = (next < count);
+        if (busy[l]) {
+            sha256_lane_start(&lane[l], state, lanes, l, messages[next], lens[next], next);
+            next++;
+            active++;
+        }
+    }
+
+    while (next < count || active > drain) {
+        for (size_t l = 0; l < lanes; l++) {
+            block[l] = busy[l] ? sha256_lane_next(&lane[l]) : idle_block;
+        }
+        kernel(state, block);
+
+        for (size_t l = 0; l < lanes; l++) {
+            if (!busy[l] || lane[l].full_blocks || lane[l].tail_blocks) continue;
+            sha256_lane_finish(&lane[l], state, lanes, l, digests[lane[l].index]);
+            if (next < count) {
+                sha256_lane_start(&lane[l], state, lanes, l, messages[next], lens[next], next);
+                next++;
+            } else {
+                busy[l] = false;
+                active--;
+            }
+        }
+    }
+
+    for (size_t l = 0; l < lanes; l++) {
+        if (busy[l]) {
+            sha256_lane_finish(&lane[l], state, lanes, l, digests[lane[l].index]);
+        }
+    }
+}
+#endif
+
 void sha256_init(sha256_ctx_t *ctx) {
     ctx->state[0] = 0x6a09e667;
     ctx->state[1] = 0xbb67ae85;
@@ -101,14 +515,15 @@ void sha256_update(sha256_ctx_t *ctx, const uint8_t *data, size_t len) {
             return;
         }
         memcpy(ctx->buffer + index, data, fill);
-        sha256_transform(ctx->state, ctx->buffer);
+        sha256_transform(ctx->state, ctx->buffer, 1);
         i = fill;
     }
     
     // Process complete blocks
-    while (i + SHA256_BLOCK_SIZE <= len) {
-        sha256_transform(ctx->state, data + i);
-        i += SHA256_BLOCK_SIZE;
+    size_t blocks = (len - i) / SHA256_BLOCK_SIZE;
+    if (blocks) {
+        sha256_transform(ctx->state, data + i, blocks);
+        i += blocks * SHA256_BLOCK_SIZE;
     }
     
     // Save remaining data
@@ -120,19 +535,21 @@ void sha256_update(sha256_ctx_t *ctx, const uint8_t *data, size_t len) {
 void sha256_final(sha256_ctx_t *ctx, uint8_t digest[SHA256_DIGEST_SIZE]) {
     uint64_t bit_len = ctx->count * 8;
     size_t index = ctx->count % SHA256_BLOCK_SIZE;
-    uint8_t pad_len = (index < 56) ? (56 - index) : ((SHA256_BLOCK_SIZE + 56) - index);
-    
-    // Padding
-    uint8_t padding[SHA256_BLOCK_SIZE] = {0x80};
-    sha256_update(ctx, padding, pad_len);
-    
-    // Append length
-    uint8_t len_buf[8];
+
+    // Padding built in place: 0x80, zeros, and the bit length in the last
+    // 8 bytes, in a second block when the first has no room left for it
+    ctx->buffer[index++] = 0x80;
+    if (index > SHA256_BLOCK_SIZE - 8) {
+        memset(ctx->buffer + index, 0, SHA256_BLOCK_SIZE - index);
+        sha256_transform(ctx->state, ctx->buffer, 1);
+        index = 0;
+    }
+    memset(ctx->buffer + index, 0, SHA256_BLOCK_SIZE - 8 - index);
     for (int i = 0; i < 8; i++) {
-        len_buf[i] = (bit_len >> (56 - i * 8)) & 0xff;
+        ctx->buffer[SHA256_BLOCK_SIZE - 1 - i] = (bit_len >> (i * 8)) & 0xff;
     }
-    sha256_update(ctx, len_buf, 8);
-    
+    sha256_transform(ctx->state, ctx->buffer, 1);
+
     // Extract digest
     for (int i = 0; i < 8; i++) {
         cpu_to_be32(digest + i * 4, ctx->state[i]);
@@ -144,4 +561,53 @@ void sha256_hash(const uint8_t *data, size_t len, uint8_t digest[SHA256_DIGEST_S
     sha256_init(&ctx);
     sha256_update(&ctx, data, len);
     sha256_final(&ctx, digest);
+}
+
+void sha256_export(const sha256_ctx_t *ctx, uint8_t checkpoint[SHA256_CHECKPOINT_SIZE]) {
+    size_t used = ctx->count % SHA256_BLOCK_SIZE;
+    memcpy(checkpoint, SHA256_CHECKPOINT_MAGIC, 4);
+    cpu_to_be32(checkpoint + 4, SHA256_CHECKPOINT_VERSION);
+    cpu_to_be32(checkpoint + 8, (uint32_t)(ctx->count >> 32));
+    cpu_to_be32(checkpoint + 12, (uint32_t)ctx->count);
+    for (int i = 0; i < 8; i++) {
+        cpu_to_be32(checkpoint + 16 + i * 4, ctx->state[i]);
+    }
+    memcpy(checkpoint + 48, ctx->buffer, used);
+    memset(checkpoint + 48 + used, 0, SHA256_BLOCK_SIZE - used);
+}
+
+int sha256_import(sha256_ctx_t *ctx, const uint8_t checkpoint[SHA256_CHECKPOINT_SIZE]) {
+    if (memcmp(checkpoint, SHA256_CHECKPOINT_MAGIC, 4) != 0 ||
+        be32_to_cpu(checkpoint + 4) != SHA256_CHECKPOINT_VERSION) {
+        return -1;
+    }
+    uint64_t count = ((uint64_t)be32_to_cpu(checkpoint + 8) << 32) | be32_to_cpu(checkpoint + 12);
+    size_t used = count % SHA256_BLOCK_SIZE;
+    // The bit length must fit in 64 bits, and the unused tail must be zero
+    if (count >> 61) return -1;
+    for (size_t i = used; i < SHA256_BLOCK_SIZE; i++) {
+        if (checkpoint[48 + i]) return -1;
+    }
+
+    for (int i = 0; i < 8; i++) {
+        ctx->state[i] = be32_to_cpu(checkpoint + 16 + i * 4);
+    }
+    ctx->count = count;
+    memcpy(ctx->buffer, checkpoint + 48, used);
+    return 0;
+}
+
+void sha256_hash_many(const uint8_t *const messages[], const size_t lens[],
+                      uint8_t digests[][SHA256_DIGEST_SIZE], size_t count) {
+#if SHA256_MULTI_BUFFER
+    size_t lanes, drain;
+    sha256_mb_fn kernel = sha256_mb_kernel(&lanes, &drain);
+    if (kernel && count > drain) {
+        sha256_hash_lanes(kernel, lanes, drain, messages, lens, digests, count);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; i++) {
+        sha256_hash(messages[i], lens[i], digests[i]);
+    }
 }
\ No newline at end of file
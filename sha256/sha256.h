@@ -7,6 +7,30 @@
 #define SHA256_DIGEST_SIZE 32
 #define SHA256_BLOCK_SIZE 64
 
+// Block function using the x86 SHA extensions (SHA-NI), picked at run time
+// from CPUID with the portable code as fallback. Only built for x86-64
+// GCC/Clang; -DSHA256_SHANI=0 leaves just the portable code.
+#ifndef SHA256_SHANI
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SHA256_SHANI 1
+#else
+#define SHA256_SHANI 0
+#endif
+#endif
+
+// Multi-buffer hashing (sha256_hash_many) in AVX2 (8 lanes) or AVX-512
+// (16 lanes), picked at run time. Only built for x86-64 GCC/Clang;
+// -DSHA256_MULTI_BUFFER=0 hashes the messages one after the other.
+#ifndef SHA256_MULTI_BUFFER
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SHA256_MULTI_BUFFER 1
+#else
+#define SHA256_MULTI_BUFFER 0
+#endif
+#endif
+// Most streams sha256_hash_many runs side by side (AVX-512: 16 lanes)
+#define SHA256_MB_MAX_LANES 16
+
 typedef struct {
     uint32_t state[8];
     uint64_t count;
@@ -18,4 +42,26 @@ void sha256_update(sha256_ctx_t *ctx, const uint8_t *data, size_t len);
 void sha256_final(sha256_ctx_t *ctx, uint8_t digest[SHA256_DIGEST_SIZE]);
 void sha256_hash(const uint8_t *data, size_t len, uint8_t digest[SHA256_DIGEST_SIZE]);
 
+// Checkpoint of a sha256_ctx_t, to resume hashing later (or in another
+// process) without the bytes already hashed. Fixed-size, byte-order
+// independent layout (integers big-endian):
+//   0  magic "S256"
+//   4  version (SHA256_CHECKPOINT_VERSION)
+//   8  message bytes hashed so far (64-bit)
+//  16  state, 8 words
+//  48  buffered tail of the message (count % 64 bytes used, the rest zero)
+// A checkpoint is not authenticated: it stands for the bytes it covers, so
+// keep it where those bytes are trusted not to change.
+#define SHA256_CHECKPOINT_VERSION 1
+#define SHA256_CHECKPOINT_SIZE (16 + 32 + SHA256_BLOCK_SIZE)
+
+void sha256_export(const sha256_ctx_t *ctx, uint8_t checkpoint[SHA256_CHECKPOINT_SIZE]);
+// Returns 0 on success, -1 for a checkpoint of another format or version, or a corrupt one
+int sha256_import(sha256_ctx_t *ctx, const uint8_t checkpoint[SHA256_CHECKPOINT_SIZE]);
+
+// Hashes count independent messages (same digests as sha256_hash on each),
+// several streams at once in SIMD lanes where the CPU allows
+void sha256_hash_many(const uint8_t *const messages[], const size_t lens[],
+                      uint8_t digests[][SHA256_DIGEST_SIZE], size_t count);
+
 #endif // SHA256_H
\ No newline at end of file
@@ -0,0 +1,256 @@
+// ========== SHA512.C ==========
+#include "sha512.h"
+#include <string.h>
+
+// SHA-512 constants
+static const uint64_t K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL,
+    0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL,
+    0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL,
+    0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+    0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL,
+    0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL,
+    0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL,
+    0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL,
+    0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+    0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL,
+    0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL,
+    0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+    0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL,
+    0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL,
+    0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+    0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL,
+    0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL,
+    0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+    0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+#define CH(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+#define SIGMA0(x) (ROTR(x, 28) ^ ROTR(x, 34) ^ ROTR(x, 39))
+#define SIGMA1(x) (ROTR(x, 14) ^ ROTR(x, 18) ^ ROTR(x, 41))
+#define GAMMA0(x) (ROTR(x, 1) ^ ROTR(x, 8) ^ ((x) >> 7))
+#define GAMMA1(x) (ROTR(x, 19) ^ ROTR(x, 61) ^ ((x) >> 6))
+
+// Big-endian word at p (any alignment): one load and a byte swap on
+// GCC/Clang little-endian targets
+static inline uint64_t be64_to_cpu(const uint8_t *p) {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__BYTE_ORDER__)
+    uint64_t val;
+    memcpy(&val, p, 8);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    val = __builtin_bswap64(val);
+#endif
+    return val;
+#else
+    uint64_t val = 0;
+    for (int i = 0; i < 8; i++) {
+        val = (val << 8) | p[i];
+    }
+    return val;
+#endif
+}
+
+static inline void cpu_to_be64(uint8_t *p, uint64_t val) {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__BYTE_ORDER__)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    val = __builtin_bswap64(val);
+#endif
+    memcpy(p, &val, 8);
+#else
+    for (int i = 7; i >= 0; i--) {
+        p[i] = val & 0xff;
+        val >>= 8;
+    }
+#endif
+}
+
+/*
+ * One round, with the working variables renamed instead of moved, as in
+ * sha256.c: a round writes only d (the next e) and h (the next a).
+ */
+#define SHA512_ROUND(a, b, c, d, e, f, g, h, i, w) do {          \
+        uint64_t t1 = (h) + SIGMA1(e) + CH(e, f, g) + K[i] + (w); \
+        (d) += t1;                                              \
+        (h) = t1 + SIGMA0(a) + MAJ(a, b, c);                    \
+    } while (0)
+
+// Message word i: loaded (i < 16), or extended in the rolling 16-word window
+#define SHA512_W(i) (W[i])
+#define SHA512_W_NEXT(i) \
+    (W[(i) & 15] += GAMMA1(W[((i) - 2) & 15]) + W[((i) - 7) & 15] + GAMMA0(W[((i) - 15) & 15]))
+
+#define SHA512_ROUNDS8(i, w)                                    \
+    SHA512_ROUND(a, b, c, d, e, f, g, h, (i) + 0, w((i) + 0));  \
+    SHA512_ROUND(h, a, b, c, d, e, f, g, (i) + 1, w((i) + 1));  \
+    SHA512_ROUND(g, h, a, b, c, d, e, f, (i) + 2, w((i) + 2));  \
+    SHA512_ROUND(f, g, h, a, b, c, d, e, (i) + 3, w((i) + 3));  \
+    SHA512_ROUND(e, f, g, h, a, b, c, d, (i) + 4, w((i) + 4));  \
+    SHA512_ROUND(d, e, f, g, h, a, b, c, (i) + 5, w((i) + 5));  \
+    SHA512_ROUND(c, d, e, f, g, h, a, b, (i) + 6, w((i) + 6));  \
+    SHA512_ROUND(b, c, d, e, f, g, h, a, (i) + 7, w((i) + 7))
+
+// Block function with fully unrolled rounds and a 16-word message schedule
+static void sha512_transform(uint64_t state[8], const uint8_t *block, size_t blocks) {
+    uint64_t W[16];
+
+    for (; blocks > 0; blocks--, block += SHA512_BLOCK_SIZE) {
+        uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int i = 0; i < 16; i++) {
+            W[i] = be64_to_cpu(block + i * 8);
+        }
+
+#if defined(__OPTIMIZE_SIZE__)
+        // -Os: one 8-round group in a loop
+        for (int i = 0; i < 16; i += 8) {
+            SHA512_ROUNDS8(i, SHA512_W);
+        }
+        for (int i = 16; i < 80; i += 8) {
+            SHA512_ROUNDS8(i, SHA512_W_NEXT);
+        }
+#else
+        SHA512_ROUNDS8(0, SHA512_W);
+        SHA512_ROUNDS8(8, SHA512_W);
+        SHA512_ROUNDS8(16, SHA512_W_NEXT);
+        SHA512_ROUNDS8(24, SHA512_W_NEXT);
+        SHA512_ROUNDS8(32, SHA512_W_NEXT);
+        SHA512_ROUNDS8(40, SHA512_W_NEXT);
+        SHA512_ROUNDS8(48, SHA512_W_NEXT);
+        SHA512_ROUNDS8(56, SHA512_W_NEXT);
+        SHA512_ROUNDS8(64, SHA512_W_NEXT);
+        SHA512_ROUNDS8(72, SHA512_W_NEXT);
+#endif
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+// Pads the message and runs the last block(s); the full digest is in state
+static void sha512_finish(sha512_ctx_t *ctx) {
+    size_t index = ctx->count % SHA512_BLOCK_SIZE;
+
+    // 0x80, zeros, and the 128-bit bit length in the last 16 bytes, in a
+    // second block when the first has no room left for it
+    ctx->buffer[index++] = 0x80;
+    if (index > SHA512_BLOCK_SIZE - 16) {
+        memset(ctx->buffer + index, 0, SHA512_BLOCK_SIZE - index);
+        sha512_transform(ctx->state, ctx->buffer, 1);
+        index = 0;
+    }
+    memset(ctx->buffer + index, 0, SHA512_BLOCK_SIZE - 16 - index);
+    cpu_to_be64(ctx->buffer + SHA512_BLOCK_SIZE - 16, ctx->count >> 61);
+    cpu_to_be64(ctx->buffer + SHA512_BLOCK_SIZE - 8, ctx->count << 3);
+    sha512_transform(ctx->state, ctx->buffer, 1);
+}
+
+void sha512_init(sha512_ctx_t *ctx) {
+    ctx->state[0] = 0x6a09e667f3bcc908ULL;
+    ctx->state[1] = 0xbb67ae8584caa73bULL;
+    ctx->state[2] = 0x3c6ef372fe94f82bULL;
+    ctx->state[3] = 0xa54ff53a5f1d36f1ULL;
+    ctx->state[4] = 0x510e527fade682d1ULL;
+    ctx->state[5] = 0x9b05688c2b3e6c1fULL;
+    ctx->state[6] = 0x1f83d9abfb41bd6bULL;
+    ctx->state[7] = 0x5be0cd19137e2179ULL;
+    ctx->count = 0;
+}
+
+void sha384_init(sha384_ctx_t *ctx) {
+    ctx->state[0] = 0xcbbb9d5dc1059ed8ULL;
+    ctx->state[1] = 0x629a292a367cd507ULL;
+    ctx->state[2] = 0x9159015a3070dd17ULL;
+    ctx->state[3] = 0x152fecd8f70e5939ULL;
+    ctx->state[4] = 0x67332667ffc00b31ULL;
+    ctx->state[5] = 0x8eb44a8768581511ULL;
+    ctx->state[6] = 0xdb0c2e0d64f98fa7ULL;
+    ctx->state[7] = 0x47b5481dbefa4fa4ULL;
+    ctx->count = 0;
+}
+
+void sha512_update(sha512_ctx_t *ctx, const uint8_t *data, size_t len) {
+    size_t i = 0;
+    size_t index = ctx->count % SHA512_BLOCK_SIZE;
+
+    ctx->count += len;
+
+    // Fill buffer
+    if (index) {
+        size_t fill = SHA512_BLOCK_SIZE - index;
+        if (len < fill) {
+            memcpy(ctx->buffer + index, data, len);
+            return;
+        }
+        memcpy(ctx->buffer + index, data, fill);
+        sha512_transform(ctx->state, ctx->buffer, 1);
+        i = fill;
+    }
+
+    // Process complete blocks
+    size_t blocks = (len - i) / SHA512_BLOCK_SIZE;
+    if (blocks) {
+        sha512_transform(ctx->state, data + i, blocks);
+        i += blocks * SHA512_BLOCK_SIZE;
+    }
+
+    // Save remaining data
+    if (i < len) {
+        memcpy(ctx->buffer, data + i, len - i);
+    }
+}
+
+void sha384_update(sha384_ctx_t *ctx, const uint8_t *data, size_t len) {
+    sha512_update(ctx, data, len);
+}
+
+void sha512_final(sha512_ctx_t *ctx, uint8_t digest[SHA512_DIGEST_SIZE]) {
+    sha512_finish(ctx);
+    for (int i = 0; i < 8; i++) {
+        cpu_to_be64(digest + i * 8, ctx->state[i]);
+    }
+}
+
+void sha384_final(sha384_ctx_t *ctx, uint8_t digest[SHA384_DIGEST_SIZE]) {
+    sha512_finish(ctx);
+    for (int i = 0; i < 6; i++) {
+        cpu_to_be64(digest + i * 8, ctx->state[i]);
+    }
+}
+
+void sha512_hash(const uint8_t *data, size_t len, uint8_t digest[SHA512_DIGEST_SIZE]) {
+    sha512_ctx_t ctx;
+    sha512_init(&ctx);
+    sha512_update(&ctx, data, len);
+    sha512_final(&ctx, digest);
+}
+
+void sha384_hash(const uint8_t *data, size_t len, uint8_t digest[SHA384_DIGEST_SIZE]) {
+    sha384_ctx_t ctx;
+    sha384_init(&ctx);
+    sha384_update(&ctx, data, len);
+    sha384_final(&ctx, digest);
+}
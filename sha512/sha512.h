@@ -0,0 +1,31 @@
+#ifndef SHA512_H
+#define SHA512_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SHA512_DIGEST_SIZE 64
+#define SHA384_DIGEST_SIZE 48
+#define SHA512_BLOCK_SIZE 128
+
+// SHA-512 and SHA-384 share the block function and context; SHA-384 only
+// starts from other initial values and keeps the first 48 digest bytes
+typedef struct {
+    uint64_t state[8];
+    uint64_t count;                     // message bytes so far
+    uint8_t buffer[SHA512_BLOCK_SIZE];
+} sha512_ctx_t;
+
+typedef sha512_ctx_t sha384_ctx_t;
+
+void sha512_init(sha512_ctx_t *ctx);
+void sha512_update(sha512_ctx_t *ctx, const uint8_t *data, size_t len);
+void sha512_final(sha512_ctx_t *ctx, uint8_t digest[SHA512_DIGEST_SIZE]);
+void sha512_hash(const uint8_t *data, size_t len, uint8_t digest[SHA512_DIGEST_SIZE]);
+
+void sha384_init(sha384_ctx_t *ctx);
+void sha384_update(sha384_ctx_t *ctx, const uint8_t *data, size_t len);
+void sha384_final(sha384_ctx_t *ctx, uint8_t digest[SHA384_DIGEST_SIZE]);
+void sha384_hash(const uint8_t *data, size_t len, uint8_t digest[SHA384_DIGEST_SIZE]);
+
+#endif // SHA512_H
@@ -0,0 +1,520 @@
+#include "bigint.h"       // bigInt_t and its primitives
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Checks of the bigint primitives against known values and a byte-wise
+// reference. Every operand and result lives in storage filled with garbage
+// above its length, so a primitive that reads or trusts words past length
+// gives a wrong value; results must also come back normalized.
+
+// Reference numbers: little-endian bytes, wide enough for any product
+#define REF_BYTES (BIGINT_MAX_WORDS * BIGINT_WORD_BYTES)
+typedef struct {
+    uint8_t b[REF_BYTES];
+} ref_t;
+
+static int failures;
+
+#define CHECK(cond, ...) do {                        \
+        if (!(cond)) {                               \
+            printf("[FAIL] " __VA_ARGS__);           \
+            printf("\n");                            \
+            failures++;                              \
+        }                                            \
+    } while (0)
+
+// xorshift64*, fixed seed so every run checks the same operands
+static uint64_t rng_state = 0x9E3779B97F4A7C15u;
+static uint64_t rng(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1Du;
+}
+
+// ---------------------------------------------------------------------------
+// Reference arithmetic
+// ---------------------------------------------------------------------------
+
+static size_t ref_len(const ref_t *a) {
+    size_t n = REF_BYTES;
+    while (n > 0 && a->b[n - 1] == 0) n--;
+    return n;
+}
+
+static int ref_cmp(const ref_t *a, const ref_t *b) {
+    for (size_t i = REF_BYTES; i-- > 0;) {
+        if (a->b[i] != b->b[i]) return (a->b[i] > b->b[i]) ? 1 : -1;
+    }
+    return 0;
+}
+
+static void ref_add(ref_t *r, const ref_t *a, const ref_t *b) {
+    unsigned carry = 0;
+    for (size_t i = 0; i < REF_BYTES; i++) {
+        carry += (unsigned)a->b[i] + b->b[i];
+        r->b[i] = (uint8_t)carry;
+        carry >>= 8;
+    }
+}
+
+// required: a >= b
+static void ref_sub(ref_t *r, const ref_t *a, const ref_t *b) {
+    int borrow = 0;
+    for (size_t i = 0; i < REF_BYTES; i++) {
+        int d = (int)a->b[i] - b->b[i] - borrow;
+        borrow = d < 0;
+        r->b[i] = (uint8_t)(d + (borrow << 8));
+    }
+}
+
+// required: the product fits in REF_BYTES
+static void ref_mul(ref_t *r, const ref_t *a, const ref_t *b) {
+    size_t an = ref_len(a), bn = ref_len(b);
+    memset(r, 0, sizeof(*r));
+    for (size_t i = 0; i < an; i++) {
+        unsigned carry = 0;
+        for (size_t j = 0; j < bn; j++) {
+            carry += (unsigned)a->b[i] * b->b[j] + r->b[i + j];
+            r->b[i + j] = (uint8_t)carry;
+            carry >>= 8;
+        }
+        for (size_t k = i + bn; carry; k++) {
+            carry += r->b[k];
+            r->b[k] = (uint8_t)carry;
+            carry >>= 8;
+        }
+    }
+}
+
+static void ref_shr(ref_t *r, const ref_t *a, size_t bits) {
+    size_t bytes = bits / 8;
+    unsigned shift = bits % 8;
+    for (size_t i = 0; i < REF_BYTES; i++) {
+        unsigned lo = (i + bytes < REF_BYTES) ? a->b[i + bytes] : 0;
+        unsigned hi = (i + bytes + 1 < REF_BYTES) ? a->b[i + bytes + 1] : 0;
+        r->b[i] = (uint8_t)(((hi << 8) | lo) >> shift);
+    }
+}
+
+// Big-endian hex string
+static void ref_from_hex(ref_t *r, const char *hex) {
+    memset(r, 0, sizeof(*r));
+    size_t n = strlen(hex);
+    for (size_t i = 0; i < n; i++) {
+        char c = hex[n - 1 - i];
+        unsigned v = (c <= '9') ? (unsigned)(c - '0') : (unsigned)(c - 'a' + 10);
+        r->b[i / 2] |= (uint8_t)(v << (4 * (i % 2)));
+    }
+}
+
+// Random value of 1..words words; some are runs of 0xff to push carries and
+// borrows through every word, some end in a short top word
+static void ref_random(ref_t *r, size_t words) {
+    memset(r, 0, sizeof(*r));
+    size_t bytes = words * BIGINT_WORD_BYTES;
+    unsigned pattern = (unsigned)(rng() % 4);
+    for (size_t i = 0; i < bytes; i++) {
+        r->b[i] = (pattern == 0) ? 0xFF : (uint8_t)rng();
+    }
+    if (pattern == 1) r->b[bytes - 1] = 0;    // top word shorter than a full one
+}
+
+// Operand length in words, biased to the edges: single words, the Karatsuba
+// threshold and the largest modulus. Edges past the largest modulus (the
+// Karatsuba ones with -DBIGINT_MAX_MOD_BITS=2048) are clamped to it.
+static size_t random_words(void) {
+    static const size_t edges[] = {
+        1, 2, 3, BIGINT_KARATSUBA_THRESHOLD - 1, BIGINT_KARATSUBA_THRESHOLD,
+        BIGINT_KARATSUBA_THRESHOLD + 1, BIGINT_MAX_MOD_WORDS - 1, BIGINT_MAX_MOD_WORDS,
+    };
+    uint64_t pick = rng() % 16;
+    if (pick < sizeof(edges) / sizeof(edges[0])) {
+        return (edges[pick] < BIGINT_MAX_MOD_WORDS) ? edges[pick] : BIGINT_MAX_MOD_WORDS;
+    }
+    return 1 + (size_t)(rng() % BIGINT_MAX_MOD_WORDS);
+}
+
+// ---------------------------------------------------------------------------
+// bigInt_t <-> reference, word by word (independent of the byte conversions)
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    bigIntWord_t words[BIGINT_MAX_WORDS];
+    bigInt_t x;
+} num_t;
+
+// Sets n to r, with garbage in every word above its length
+static void num_set(num_t *n, const ref_t *r) {
+    for (size_t i = 0; i < BIGINT_MAX_WORDS; i++) n->words[i] = (bigIntWord_t)rng() | 1;
+    bigint_init(&n->x, n->words, BIGINT_MAX_WORDS);
+    size_t len = (ref_len(r) + BIGINT_WORD_BYTES - 1) / BIGINT_WORD_BYTES;
+    if (len == 0) len = 1;
+    for (size_t i = 0; i < len; i++) {
+        bigIntWord_t w = 0;
+        for (size_t j = BIGINT_WORD_BYTES; j-- > 0;) w = (w << 8) | r->b[i * BIGINT_WORD_BYTES + j];
+        n->words[i] = w;
+    }
+    n->x.length = (uint32_t)len;
+}
+
+// Garbage-filled result storage (value 0)
+static void num_garbage(num_t *n) {
+    for (size_t i = 0; i < BIGINT_MAX_WORDS; i++) n->words[i] = (bigIntWord_t)rng() | 1;
+    bigint_init(&n->x, n->words, BIGINT_MAX_WORDS);
+}
+
+// x is normalized and equal to r
+static bool num_equals(const bigInt_t *x, const ref_t *r) {
+    if (x->length == 0 || x->length > x->capacity) return false;
+    if (x->length > 1 && x->words[x->length - 1] == 0) return false;
+    ref_t v;
+    memset(&v, 0, sizeof(v));
+    for (size_t i = 0; i < x->length; i++) {
+        for (size_t j = 0; j < BIGINT_WORD_BYTES; j++) {
+            v.b[i * BIGINT_WORD_BYTES + j] = (uint8_t)(x->words[i] >> (8 * j));
+        }
+    }
+    return ref_cmp(&v, r) == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Checks
+// ---------------------------------------------------------------------------
+
+// Known results: carries out of the top word, a borrow chain, and
+// products of all-ones values
+static void test_known_values(void) {
+    static const char *m521 =
+        "1ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+        "ffffffffffffffffffffffffffffffffffffffffffffffffffffff";
+    static const char *b256 = "fedcba9876543210f0e1d2c3b4a5968778695a4b3c2d1e0f0123456789abcdef";
+    static const char *sum =
+        "2000000000000000000000000000000000000000000000000000000000000000000fedcba9876"
+        "543210f0e1d2c3b4a5968778695a4b3c2d1e0f0123456789abcdee";
+    static const char *diff =
+        "1ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff0123456789"
+        "abcdef0f1e2d3c4b5a69788796a5b4c3d2e1f0fedcba9876543210";
+    static const char *prod =
+        "1fdb97530eca86421e1c3a587694b2d0ef0d2b496785a3c1e02468acf13579bddfffffffffff"
+        "fffffffffffffffffffffffffffffffffffffffffffffffffffffff0123456789abcdef0f1e2"
+        "d3c4b5a69788796a5b4c3d2e1f0fedcba9876543211";
+    static const char *sqr =
+        "3fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+        "ffffffffffffffffffffffffffffffffffffffffffffffffffffffc000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000000000000000000"
+        "000000000000000000000000000000001";
+    static const char *shr67 =
+        "3fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+        "ffffffffffffffffffffffffffffffffffff";
+
+    ref_t a, b, want;
+    num_t x, y, r;
+    ref_from_hex(&a, m521);
+    ref_from_hex(&b, b256);
+
+    num_set(&x, &a); num_set(&y, &b); num_garbage(&r);
+    ref_from_hex(&want, sum);
+    CHECK(bigint_add(&r.x, &x.x, &y.x) == BIGINT_OK && num_equals(&r.x, &want), "known: 2^521-1 + b");
+    ref_from_hex(&want, diff);
+    CHECK(bigint_sub(&r.x, &x.x, &y.x) == BIGINT_OK && num_equals(&r.x, &want), "known: 2^521-1 - b");
+    ref_from_hex(&want, prod);
+    CHECK(bigint_mul(&r.x, &x.x, &y.x) == BIGINT_OK && num_equals(&r.x, &want), "known: (2^521-1) * b");
+    ref_from_hex(&want, sqr);
+    CHECK(bigint_sqr(&r.x, &x.x) == BIGINT_OK && num_equals(&r.x, &want), "known: (2^521-1)^2");
+    ref_from_hex(&want, shr67);
+    CHECK(bigint_shift_right(&x.x, 67) == BIGINT_OK && num_equals(&x.x, &want), "known: (2^521-1) >> 67");
+
+    ref_from_hex(&a, "ffffffffffffffff");
+    ref_from_hex(&want, "fffffffffffffffe0000000000000001");
+    num_set(&x, &a);
+    CHECK(bigint_mul(&x.x, &x.x, &x.x) == BIGINT_OK && num_equals(&x.x, &want), "known: (2^64-1)^2 in place");
+
+    num_set(&x, &a);
+    CHECK(bigint_zero(&x.x) == BIGINT_OK && x.x.length == 1 && x.x.words[0] == 0, "known: bigint_zero");
+    ref_from_hex(&want, "89abcdef");
+    CHECK(bigint_from_uint32(&x.x, 0x89ABCDEFu) == BIGINT_OK && num_equals(&x.x, &want), "known: bigint_from_uint32");
+}
+
+// add/sub/mul/sqr with the result in separate storage and aliased to each operand
+static void test_aliasing(unsigned rounds) {
+    for (unsigned round = 0; round < rounds; round++) {
+        ref_t a, b, want, zero;
+        num_t x, y, r;
+        ref_random(&a, random_words());
+        ref_random(&b, random_words());
+        memset(&zero, 0, sizeof(zero));
+
+        ref_add(&want, &a, &b);
+        num_set(&x, &a); num_set(&y, &b); num_garbage(&r);
+        CHECK(bigint_add(&r.x, &x.x, &y.x) == BIGINT_OK && num_equals(&r.x, &want), "add, round %u", round);
+        CHECK(bigint_add(&x.x, &x.x, &y.x) == BIGINT_OK && num_equals(&x.x, &want), "add res == a, round %u", round);
+        num_set(&x, &a);
+        CHECK(bigint_add(&y.x, &x.x, &y.x) == BIGINT_OK && num_equals(&y.x, &want), "add res == b, round %u", round);
+        ref_add(&want, &a, &a);
+        num_set(&x, &a);
+        CHECK(bigint_add(&x.x, &x.x, &x.x) == BIGINT_OK && num_equals(&x.x, &want), "add res == a == b, round %u", round);
+
+        // a >= b for the subtractions
+        const ref_t *hi = (ref_cmp(&a, &b) >= 0) ? &a : &b;
+        const ref_t *lo = (hi == &a) ? &b : &a;
+        ref_sub(&want, hi, lo);
+        num_set(&x, hi); num_set(&y, lo); num_garbage(&r);
+        CHECK(bigint_sub(&r.x, &x.x, &y.x) == BIGINT_OK && num_equals(&r.x, &want), "sub, round %u", round);
+        CHECK(bigint_sub(&x.x, &x.x, &y.x) == BIGINT_OK && num_equals(&x.x, &want), "sub res == a, round %u", round);
+        num_set(&x, hi);
+        CHECK(bigint_sub(&y.x, &x.x, &y.x) == BIGINT_OK && num_equals(&y.x, &want), "sub res == b, round %u", round);
+        CHECK(bigint_sub(&x.x, &x.x, &x.x) == BIGINT_OK && num_equals(&x.x, &zero), "sub a - a, round %u", round);
+        num_set(&x, lo); num_set(&y, hi);
+        CHECK(ref_cmp(hi, lo) == 0 || bigint_sub(&r.x, &x.x, &y.x) == BIGINT_ERR_OVERFLOW,
+              "sub a < b rejected, round %u", round);
+
+        ref_mul(&want, &a, &b);
+        num_set(&x, &a); num_set(&y, &b); num_garbage(&r);
+        CHECK(bigint_mul(&r.x, &x.x, &y.x) == BIGINT_OK && num_equals(&r.x, &want), "mul, round %u", round);
+        CHECK(bigint_mul(&x.x, &x.x, &y.x) == BIGINT_OK && num_equals(&x.x, &want), "mul res == a, round %u", round);
+        num_set(&x, &a);
+        CHECK(bigint_mul(&y.x, &x.x, &y.x) == BIGINT_OK && num_equals(&y.x, &want), "mul res == b, round %u", round);
+
+        ref_mul(&want, &a, &a);
+        num_set(&x, &a); num_garbage(&r);
+        CHECK(bigint_sqr(&r.x, &x.x) == BIGINT_OK && num_equals(&r.x, &want), "sqr, round %u", round);
+        CHECK(bigint_sqr(&x.x, &x.x) == BIGINT_OK && num_equals(&x.x, &want), "sqr res == a, round %u", round);
+        num_set(&x, &a);
+        CHECK(bigint_mul(&x.x, &x.x, &x.x) == BIGINT_OK && num_equals(&x.x, &want), "mul res == a == b, round %u", round);
+
+        num_set(&x, &a);
+        CHECK(bigint_copy(&r.x, &x.x) == BIGINT_OK && num_equals(&r.x, &a), "copy, round %u", round);
+    }
+}
+
+// Results whose top words cancel must come back with their true length
+static void test_normalization(unsigned rounds) {
+    for (unsigned round = 0; round < rounds; round++) {
+        ref_t a, c, b, want;
+        num_t x, y;
+        ref_random(&a, random_words());
+        memset(&c, 0, sizeof(c));
+        c.b[0] = (uint8_t)rng();
+        if (ref_cmp(&a, &c) < 0) continue;
+
+        // a - (a - c) = c, a single word
+        ref_sub(&b, &a, &c);
+        num_set(&x, &a); num_set(&y, &b);
+        CHECK(bigint_sub(&x.x, &x.x, &y.x) == BIGINT_OK && num_equals(&x.x, &c), "sub down to one word, round %u", round);
+
+        // Right shifts by every word and bit offset down to zero
+        size_t bits = ref_len(&a) * 8 + 8;
+        for (size_t shift = 0; shift <= bits; shift += 1 + (size_t)(rng() % 23)) {
+            ref_shr(&want, &a, shift);
+            num_set(&x, &a);
+            CHECK(bigint_shift_right(&x.x, shift) == BIGINT_OK && num_equals(&x.x, &want),
+                  "shift right %zu, round %u", shift, round);
+        }
+
+        // Left shift and back restores the value (operands are at most half the capacity)
+        size_t shift = (size_t)(rng() % (BIGINT_WORD_BITS * 3));
+        num_set(&x, &a);
+        CHECK(bigint_shift_left(&x.x, shift) == BIGINT_OK && bigint_shift_right(&x.x, shift) == BIGINT_OK &&
+              num_equals(&x.x, &a), "shift left/right %zu, round %u", shift, round);
+    }
+}
+
+// bigint_divmod against the reference (q * m + r == a, r < m), then
+// bigint_mod_barrett against bigint_mod, for even and odd moduli and inputs
+// up to and past 2k words, including multiples of m and all-ones values
+static void test_reduction(unsigned rounds) {
+    for (unsigned round = 0; round < rounds; round++) {
+        ref_t m, a, q, t, want;
+        num_t mn, an, qn, rn, bn;
+        size_t k = random_words();
+        ref_random(&m, k);
+        if (ref_len(&m) == 0) m.b[0] = 1;
+        k = (ref_len(&m) + BIGINT_WORD_BYTES - 1) / BIGINT_WORD_BYTES;
+
+        switch (round % 4) {
+        case 0:     // exact multiple: remainder 0
+            ref_random(&q, k);
+            ref_mul(&a, &m, &q);
+            break;
+        case 1:     // B^2k - 1, the largest Barrett input
+            memset(&a, 0, sizeof(a));
+            memset(a.b, 0xFF, 2 * k * BIGINT_WORD_BYTES);
+            break;
+        case 2:     // past 2k words: the bigint_mod fallback
+            ref_random(&a, (2 * k + 1 < BIGINT_MAX_WORDS) ? 2 * k + 1 : BIGINT_MAX_WORDS);
+            break;
+        default:
+            ref_random(&a, 1 + (size_t)(rng() % (2 * k)));
+            break;
+        }
+
+        num_set(&mn, &m); num_set(&an, &a); num_garbage(&qn); num_garbage(&rn);
+        bool ok = bigint_divmod(&qn.x, &rn.x, &an.x, &mn.x) == BIGINT_OK;
+        ref_t qr, rr;
+        memset(&qr, 0, sizeof(qr));
+        memset(&rr, 0, sizeof(rr));
+        for (size_t i = 0; ok && i < qn.x.length * BIGINT_WORD_BYTES; i++) {
+            qr.b[i] = (uint8_t)(qn.x.words[i / BIGINT_WORD_BYTES] >> (8 * (i % BIGINT_WORD_BYTES)));
+        }
+        for (size_t i = 0; ok && i < rn.x.length * BIGINT_WORD_BYTES; i++) {
+            rr.b[i] = (uint8_t)(rn.x.words[i / BIGINT_WORD_BYTES] >> (8 * (i % BIGINT_WORD_BYTES)));
+        }
+        ref_mul(&t, &qr, &m);
+        ref_add(&want, &t, &rr);
+        CHECK(ok && ref_cmp(&want, &a) == 0 && ref_cmp(&rr, &m) < 0 && num_equals(&rn.x, &rr),
+              "divmod, %zu-word modulus, round %u", k, round);
+
+        bigIntBarrettCtx_t ctx;
+        num_garbage(&bn);
+        CHECK(bigint_barrett_init(&ctx, &mn.x) == BIGINT_OK &&
+              bigint_mod_barrett(&bn.x, &an.x, &ctx) == BIGINT_OK && num_equals(&bn.x, &rr),
+              "barrett, %zu-word modulus, round %u", k, round);
+        CHECK(bigint_mod_barrett(&an.x, &an.x, &ctx) == BIGINT_OK && num_equals(&an.x, &rr),
+              "barrett res == a, %zu-word modulus, round %u", k, round);
+        CHECK(bigint_mod(&bn.x, &an.x, &mn.x) == BIGINT_OK && num_equals(&bn.x, &rr),
+              "bigint_mod, %zu-word modulus, round %u", k, round);
+    }
+}
+
+// One bigint_from_bytes / bigint_to_bytes round trip of in[0..len) through
+// buffers at the given misalignment
+static void check_bytes(const uint8_t *in, size_t len, size_t offset) {
+    static uint8_t src_buf[BIGINT_MAX_WORDS * BIGINT_WORD_BYTES + 64];
+    static uint8_t out_buf[BIGINT_MAX_WORDS * BIGINT_WORD_BYTES + 64];
+    uint8_t *src = src_buf + offset;
+    memcpy(src, in, len);
+
+    // Value as the reference sees it (little-endian) and its significant length
+    ref_t want;
+    memset(&want, 0, sizeof(want));
+    for (size_t i = 0; i < len; i++) want.b[i] = src[len - 1 - i];
+    size_t sig = ref_len(&want);
+
+    num_t x;
+    num_garbage(&x);
+    CHECK(bigint_from_bytes(&x.x, src, len) == BIGINT_OK && num_equals(&x.x, &want),
+          "from_bytes, %zu bytes at offset %zu", len, offset);
+
+    // Exact size, significant bytes only, and zero-padded up to 9 bytes wider
+    for (size_t target = sig; target <= len + 9; target = (target < len) ? len : target + 1) {
+        uint8_t *out = out_buf + 8 + offset;     // guard bytes on both sides
+        memset(out_buf, 0xA5, sizeof(out_buf));
+        bool ok = bigint_to_bytes(&x.x, out, target) == BIGINT_OK;
+        for (size_t i = 0; ok && i < target; i++) {
+            ok = out[target - 1 - i] == want.b[i];
+        }
+        ok = ok && out[target] == 0xA5 && out[-1] == 0xA5;
+        CHECK(ok, "to_bytes, %zu bytes into %zu at offset %zu", len, target, offset);
+    }
+
+    // One byte short: overflow, output untouched
+    if (sig > 0) {
+        uint8_t *out = out_buf + 8 + offset;
+        memset(out_buf, 0xA5, sizeof(out_buf));
+        bool ok = bigint_to_bytes(&x.x, out, sig - 1) == BIGINT_ERR_OVERFLOW;
+        for (size_t i = 0; ok && i < sig; i++) ok = out[i] == 0xA5 && out[-1] == 0xA5;
+        CHECK(ok, "to_bytes overflow, %zu bytes into %zu at offset %zu", sig, sig - 1, offset);
+    }
+}
+
+// Longest conversion checked: the largest modulus and one word more (520
+// bytes in the default build)
+#define BYTES_MAX (BIGINT_MAX_MOD_WORDS * BIGINT_WORD_BYTES + 8)
+
+// Byte/limb conversions: every length 0..BYTES_MAX at every misalignment, with
+// random, all-0xff and leading-zero values; 256/384/512-byte values with the
+// top bit set (RSA moduli and signatures, as far as the build supports them);
+// and inputs too big for the capacity
+static void test_bytes(unsigned rounds) {
+    uint8_t in[BYTES_MAX];
+    for (size_t len = 0; len <= sizeof(in); len++) {
+        for (size_t offset = 0; offset < BIGINT_WORD_BYTES; offset++) {
+            for (unsigned pattern = 0; pattern < 4; pattern++) {
+                for (size_t i = 0; i < len; i++) in[i] = (pattern == 1) ? 0xFF : (uint8_t)rng();
+                if (pattern == 2) memset(in, 0, len / 3 + 1 < len ? len / 3 + 1 : len);  // leading zeros
+                if (pattern == 3) memset(in, 0, len);                                    // zero
+                check_bytes(in, len, offset);
+            }
+        }
+    }
+
+    static const size_t rsa_sizes[] = { 256, 384, 512 };
+    for (unsigned round = 0; round < rounds; round++) {
+        for (size_t s = 0; s < sizeof(rsa_sizes) / sizeof(rsa_sizes[0]); s++) {
+            if (rsa_sizes[s] > BIGINT_MAX_MOD_WORDS * BIGINT_WORD_BYTES) break;
+            for (size_t i = 0; i < rsa_sizes[s]; i++) in[i] = (uint8_t)rng();
+            in[0] |= 0x80;
+            check_bytes(in, rsa_sizes[s], (size_t)(rng() % 8));
+        }
+    }
+
+    // Capacity of 2 words: 2 words of significant bytes fit even after many
+    // leading zeros, one byte more does not
+    bigIntWord_t small_words[2];
+    bigInt_t small;
+    bigint_init(&small, small_words, 2);
+    memset(in, 0, sizeof(in));
+    memset(in + 100, 0x80, 2 * BIGINT_WORD_BYTES);
+    CHECK(bigint_from_bytes(&small, in, 100 + 2 * BIGINT_WORD_BYTES) == BIGINT_OK && small.length == 2,
+          "from_bytes with leading zeros past the capacity");
+    in[99] = 1;
+    CHECK(bigint_from_bytes(&small, in, 100 + 2 * BIGINT_WORD_BYTES) == BIGINT_ERR_OVERFLOW,
+          "from_bytes past the capacity");
+}
+
+// bigint_mont_exp_uint_batch with a NULL result: BIGINT_ERR_NULL both from a
+// batch long enough for the vector lanes and from the scalar loop, and the
+// other results still computed
+static void test_batch_null(void) {
+    static num_t base[16], res[16], want;
+    ref_t m, a;
+    num_t mn;
+    ref_random(&m, BIGINT_MAX_MOD_WORDS);
+    m.b[0] |= 1;
+    m.b[BIGINT_MAX_MOD_WORDS * BIGINT_WORD_BYTES - 1] |= 0x80;
+    num_set(&mn, &m);
+    bigIntMontCtx_t ctx;
+    CHECK(bigint_mont_init(&ctx, &mn.x) == BIGINT_OK, "mont_init for the batch");
+
+    const bigInt_t *bp[16];
+    bigInt_t *rp[16];
+    for (size_t i = 0; i < 16; i++) {
+        ref_random(&a, BIGINT_MAX_MOD_WORDS - 1);
+        num_set(&base[i], &a);
+        num_garbage(&res[i]);
+        bp[i] = &base[i].x;
+        rp[i] = (i == 5) ? NULL : &res[i].x;
+    }
+    CHECK(bigint_mont_exp_uint_batch(rp, bp, 16, 65537, &ctx) == BIGINT_ERR_NULL,
+          "batch of 16 with a NULL result");
+    for (size_t i = 0; i < 16; i++) {
+        if (i == 5) continue;
+        num_garbage(&want);
+        CHECK(bigint_mont_exp_uint(&want.x, bp[i], 65537, &ctx) == BIGINT_OK &&
+              bigint_compare(&want.x, &res[i].x) == 0, "batch of 16 with a NULL result, item %zu", i);
+    }
+    CHECK(bigint_mont_exp_uint_batch(rp + 5, bp + 5, 1, 65537, &ctx) == BIGINT_ERR_NULL,
+          "batch of 1 with a NULL result");
+}
+
+int main(int argc, char **argv) {
+    unsigned rounds = (argc > 1) ? (unsigned)strtoul(argv[1], NULL, 10) : 200;
+    printf("[INFO] %d-bit limbs, %u rounds\n", BIGINT_WORD_BITS, rounds);
+
+    test_known_values();
+    test_aliasing(rounds);
+    test_normalization(rounds);
+    test_reduction(rounds);
+    test_bytes(rounds);
+    test_batch_null();
+
+    if (failures) {
+        printf("[FAIL] %d bigint checks failed\n", failures);
+        return 1;
+    }
+    printf("[SUCCESS] bigint add/sub/mul/sqr/shift: aliasing and normalization; divmod and Barrett reduction; byte round trips; NULL results in a batch\n");
+    return 0;
+}
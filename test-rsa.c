@@ -1,10 +1,310 @@
 #include "rsa_keys.h"     // chứa modulus, exponent
 #include "rsa2048.h"      // verify_firmware()
+#include "rsa_file.h"     // rsa_verify_file()
+#include "rsa_pool.h"     // rsa_verify_batch()
+#include "rsa_cache.h"    // rsa_verify_file_cached()
+#include "rsa_keyring.h"  // rsa_verify_with_key_id()
+#include "rsa_keygen.h"   // rsa_generate_key()
+#include "rsa_manifest.h" // verify_firmware_manifest()
 #include "bigint.h"       // mod_exp, bigint_t
 #include "sha256.h"       // sha256_hash()
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#ifndef _WIN32
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+// Reads a whole file, NULL if it cannot be opened
+static uint8_t *read_file(const char *path, size_t *size) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *data = malloc(*size ? *size : 1);
+    if (data && fread(data, 1, *size, f) != *size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    return data;
+}
+
+// Multi-buffer SHA-256 against sha256_hash: lengths around the padding
+// boundaries (55/56, 63/64) mixed with multi-block ones, and more messages
+// than SIMD lanes so lanes are refilled and the last ones drained
+static bool test_sha256_many(const uint8_t *data, size_t size) {
+    static const size_t lengths[] = { 0, 1, 55, 56, 63, 64, 65, 119, 120, 128, 1000, 4099, 65536 + 17 };
+    enum { COUNT = 3 * sizeof(lengths) / sizeof(lengths[0]) };
+    const uint8_t *messages[COUNT];
+    size_t lens[COUNT];
+    uint8_t digests[COUNT][SHA256_DIGEST_SIZE], expected[SHA256_DIGEST_SIZE];
+    for (size_t i = 0; i < COUNT; i++) {
+        // Rotate the length list so long and short messages share the lanes
+        lens[i] = lengths[(i * 5) % (sizeof(lengths) / sizeof(lengths[0]))];
+        if (lens[i] > size) lens[i] = size;
+        messages[i] = data + (i * 37) % (size - lens[i] + 1);
+    }
+    sha256_hash_many(messages, lens, digests, COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        sha256_hash(messages[i], lens[i], expected);
+        if (memcmp(digests[i], expected, SHA256_DIGEST_SIZE) != 0) {
+            printf("[FAIL] sha256_hash_many: message %zu (%zu bytes) differs from sha256_hash\n", i, lens[i]);
+            return false;
+        }
+    }
+    printf("[SUCCESS] sha256_hash_many matches sha256_hash on %d messages\n", (int)COUNT);
+    return true;
+}
+
+// Keyring: the embedded key among 39 made-up ones (enough to grow the table
+// past its 16 initial buckets), duplicate and unknown IDs, and a key removed
+// while a verification still holds it, then added back in DER form
+static bool test_keyring(const uint8_t *firmware_data, size_t firmware_size) {
+    rsa_keyring_t ring;
+    uint8_t id[RSA_KEY_ID_SIZE], other_id[RSA_KEY_ID_SIZE], unknown_id[RSA_KEY_ID_SIZE];
+    uint8_t modulus[RSA_KEY_SIZE + 1];
+    bool ok = rsa_keyring_init(&ring) == RSA_KEYRING_OK &&
+              rsa_keyring_add(&ring, rsa_modulus, RSA_KEY_SIZE, rsa_exponent, id) == RSA_KEYRING_OK;
+    for (size_t i = 1; ok && i < 40; i++) {
+        memcpy(modulus, rsa_modulus, RSA_KEY_SIZE);
+        modulus[RSA_KEY_SIZE / 2] ^= (uint8_t)i;     // still odd, still full length
+        ok = rsa_keyring_add(&ring, modulus, RSA_KEY_SIZE, rsa_exponent, other_id) == RSA_KEYRING_OK;
+    }
+    if (!ok || ring.count != 40 || ring.bucket_count <= 16) {
+        printf("[FAIL] Keyring: adding 40 keys (%zu keys, %zu buckets)\n", ring.count, ring.bucket_count);
+        rsa_keyring_free(&ring);
+        return false;
+    }
+
+    // The same modulus again, also with a leading zero byte, has the same ID
+    modulus[0] = 0;
+    memcpy(modulus + 1, rsa_modulus, RSA_KEY_SIZE);
+    memset(unknown_id, 0x5A, sizeof(unknown_id));
+    ok = rsa_keyring_add(&ring, rsa_modulus, RSA_KEY_SIZE, rsa_exponent, NULL) == RSA_KEYRING_EXISTS &&
+         rsa_keyring_add(&ring, modulus, RSA_KEY_SIZE + 1, rsa_exponent, NULL) == RSA_KEYRING_EXISTS &&
+         ring.count == 40 &&
+         rsa_verify_with_key_id(&ring, id, firmware_data, firmware_size,
+                                firmware_signature, SIGNATURE_SIZE) == RSA_VERIFY_OK &&
+         rsa_verify_with_key_id(&ring, other_id, firmware_data, firmware_size,
+                                firmware_signature, SIGNATURE_SIZE) < RSA_VERIFY_ERROR &&
+         rsa_verify_with_key_id(&ring, unknown_id, firmware_data, firmware_size,
+                                firmware_signature, SIGNATURE_SIZE) == RSA_VERIFY_UNKNOWN_KEY &&
+         rsa_keyring_acquire(&ring, unknown_id) == NULL;
+    if (!ok) {
+        printf("[FAIL] Keyring: duplicate, known or unknown key ID\n");
+        rsa_keyring_free(&ring);
+        return false;
+    }
+
+    // Removed while acquired: the holder keeps a usable key, the ring forgets it
+    const rsa_public_key_t *pinned = rsa_keyring_acquire(&ring, id);
+    ok = pinned && rsa_keyring_remove(&ring, id) == RSA_KEYRING_OK &&
+         rsa_keyring_remove(&ring, id) == RSA_KEYRING_NOT_FOUND &&
+         rsa_keyring_acquire(&ring, id) == NULL &&
+         rsa_verify_with_key_id(&ring, id, firmware_data, firmware_size,
+                                firmware_signature, SIGNATURE_SIZE) == RSA_VERIFY_UNKNOWN_KEY &&
+         rsa_verify_with_key(pinned, firmware_data, firmware_size,
+                             firmware_signature, SIGNATURE_SIZE) == RSA_VERIFY_OK &&
+         ring.count == 39;
+    rsa_keyring_release(pinned);
+
+    // Added back in DER form (leading zero byte): same ID, and the usual
+    // SIGNATURE_SIZE-byte signature still verifies
+    ok = ok && rsa_keyring_add(&ring, modulus, RSA_KEY_SIZE + 1, rsa_exponent, other_id) == RSA_KEYRING_OK &&
+         memcmp(other_id, id, RSA_KEY_ID_SIZE) == 0 &&
+         rsa_verify_with_key_id(&ring, id, firmware_data, firmware_size,
+                                firmware_signature, SIGNATURE_SIZE) == RSA_VERIFY_OK;
+    rsa_keyring_free(&ring);
+    if (!ok) {
+        printf("[FAIL] Keyring: key removed while acquired, or added back in DER form\n");
+        return false;
+    }
+    printf("[SUCCESS] Keyring: 40 keys, duplicate/unknown IDs, removal while acquired, DER-form modulus\n");
+    return true;
+}
+
+#ifndef _WIN32
+// Verification cache on a copy of firmware.bin with its mtime set an hour
+// back: the first check hashes it, the second is answered from the cache,
+// and the copy changed in place (same size, mtime set back again) misses.
+// ctime cannot be set back, so the test waits RSA_CACHE_RACY_SECONDS first.
+static bool test_cache(const rsa_public_key_t *key, const uint8_t *firmware_data, size_t firmware_size) {
+    const char *path = "./genkey/cache_test.bin";
+    const char *cache_path = "./genkey/cache_test.cache";
+    struct utimbuf old_times;
+    old_times.actime = old_times.modtime = time(NULL) - 3600;
+    remove(cache_path);
+
+    FILE *f = fopen(path, "wb");
+    bool ok = f && fwrite(firmware_data, 1, firmware_size, f) == firmware_size;
+    if (f && fclose(f) != 0) ok = false;
+    if (!ok || utime(path, &old_times) != 0) {
+        printf("[FAIL] Cache: cannot write %s\n", path);
+        remove(path);
+        return false;
+    }
+    sleep(RSA_CACHE_RACY_SECONDS + 1);
+
+    rsa_verify_cache_t cache;
+    if (rsa_verify_cache_open(&cache, cache_path) != RSA_VERIFY_OK) {
+        printf("[FAIL] Cache: cannot open %s\n", cache_path);
+        remove(path);
+        return false;
+    }
+    rsa_file_stats_t stats;
+    bool hits[2] = { false, false };
+    for (int pass = 0; ok && pass < 2; pass++) {
+        ok = rsa_verify_file_cached(&cache, path, key, firmware_signature, SIGNATURE_SIZE,
+                                    RSA_FILE_IO_MMAP, 0, &stats) == RSA_VERIFY_OK;
+        hits[pass] = stats.cache_hit;
+    }
+    if (!ok || hits[0] || !hits[1]) {
+        printf("[FAIL] Cache: expected a miss then a hit (valid: %d, hits: %d %d)\n", ok, hits[0], hits[1]);
+        ok = false;
+    }
+
+    // A corrupted signature of the right size is rejected before the file is
+    // read: stats come back zeroed over the stale ones, and nothing is stored
+    if (ok) {
+        uint8_t bad_signature[SIGNATURE_SIZE];
+        memcpy(bad_signature, firmware_signature, SIGNATURE_SIZE);
+        bad_signature[SIGNATURE_SIZE / 2] ^= 0x01;
+        size_t entries = cache.count;
+        for (int pass = 0; ok && pass < 2; pass++) {
+            memset(&stats, 0x41, sizeof(stats));
+            ok = rsa_verify_file_cached(&cache, path, key, bad_signature, SIGNATURE_SIZE,
+                                        RSA_FILE_IO_MMAP, 0, &stats) < RSA_VERIFY_ERROR &&
+                 !stats.cache_hit && stats.bytes == 0 && stats.alg == RSA_HASH_SHA256 &&
+                 cache.count == entries;
+        }
+        if (!ok) printf("[FAIL] Cache: a corrupted signature was cached or left stale stats\n");
+    }
+
+    // One byte changed in place: size, inode and mtime are the same, ctime is not
+    if (ok) {
+        f = fopen(path, "r+b");
+        uint8_t byte = firmware_data[firmware_size / 2] ^ 0x01;
+        ok = f && fseek(f, (long)(firmware_size / 2), SEEK_SET) == 0 && fwrite(&byte, 1, 1, f) == 1;
+        if (f && fclose(f) != 0) ok = false;
+        ok = ok && utime(path, &old_times) == 0 &&
+             rsa_verify_file_cached(&cache, path, key, firmware_signature, SIGNATURE_SIZE,
+                                    RSA_FILE_IO_MMAP, 0, &stats) == RSA_VERIFY_INVALID_SIGNATURE &&
+             !stats.cache_hit;
+        if (!ok) printf("[FAIL] Cache: a changed file was not verified again\n");
+    }
+    rsa_verify_cache_close(&cache);
+    remove(path);
+    remove(cache_path);
+    if (ok) printf("[SUCCESS] Cache: miss, hit, corrupted signature never cached, miss once the file changed\n");
+    return ok;
+}
+#endif
+
+// Batch verification from a caller-supplied workspace: 20 items (a full chunk
+// and a partial one), the last of each chunk tampered, then unusable workspaces
+static bool test_verify_batch(const rsa_public_key_t *key, const uint8_t *firmware_data, size_t firmware_size) {
+    static _Alignas(RSA_WORKSPACE_ALIGN) uint8_t workspace[RSA_VERIFY_BATCH_WORKSPACE_MAX + RSA_WORKSPACE_ALIGN];
+    rsa_verify_item_t items[20];
+    rsa_verify_result_t results[20];
+    uint8_t bad_signature[SIGNATURE_SIZE];
+    memcpy(bad_signature, firmware_signature, SIGNATURE_SIZE);
+    bad_signature[SIGNATURE_SIZE / 2] ^= 0x01;
+    for (size_t i = 0; i < 20; i++) {
+        bool bad = (i == RSA_VERIFY_BATCH_CHUNK - 1 || i == 19);
+        items[i] = (rsa_verify_item_t){ firmware_data, firmware_size, bad ? bad_signature : firmware_signature };
+    }
+
+    size_t size = RSA_VERIFY_BATCH_WORKSPACE_SIZE(key->mod_len);
+    rsa_verify_result_t overall = rsa_verify_batch_with_key_ws(key, items, results, 20, workspace, size);
+    bool ok = overall < RSA_VERIFY_ERROR && overall == results[RSA_VERIFY_BATCH_CHUNK - 1];
+    for (size_t i = 0; i < 20; i++) {
+        bool bad = (i == RSA_VERIFY_BATCH_CHUNK - 1 || i == 19);
+        ok = ok && (bad ? results[i] < RSA_VERIFY_ERROR : results[i] == RSA_VERIFY_OK);
+    }
+    ok = ok && rsa_verify_batch_with_key(key, items, results, RSA_VERIFY_BATCH_CHUNK - 1) == RSA_VERIFY_OK;
+
+    // Too small or misaligned: every item is an error
+    ok = ok && rsa_verify_batch_with_key_ws(key, items, results, 2, workspace, size - 1) == RSA_VERIFY_ERROR &&
+         results[0] == RSA_VERIFY_ERROR && results[1] == RSA_VERIFY_ERROR &&
+         rsa_verify_batch_with_key_ws(key, items, results, 2, workspace + 8, size) == RSA_VERIFY_ERROR &&
+         rsa_verify_batch_with_key_ws(key, items, results, 2, NULL, size) == RSA_VERIFY_ERROR;
+    if (ok) {
+        printf("[SUCCESS] Batch verification from a %zu-byte workspace\n", size);
+    } else {
+        printf("[FAIL] Batch verification with a workspace\n");
+    }
+    return ok;
+}
+
+// Deterministic random source for the key generation test: SHA-256 of a fixed
+// seed and a counter, so the same key comes out on every run with one thread
+typedef struct {
+    pthread_mutex_t lock;
+    uint64_t counter;
+} test_rng_t;
+
+static int test_rng(void *ctx, uint8_t *buf, size_t len) {
+    test_rng_t *rng = ctx;
+    uint8_t block[SHA256_DIGEST_SIZE];
+    pthread_mutex_lock(&rng->lock);
+    for (size_t i = 0; i < len; i += sizeof(block)) {
+        uint8_t seed[16] = "test-rsa";
+        memcpy(seed + 8, &rng->counter, sizeof(rng->counter));
+        rng->counter++;
+        sha256_hash(seed, sizeof(seed), block);
+        memcpy(buf + i, block, (len - i < sizeof(block)) ? len - i : sizeof(block));
+    }
+    pthread_mutex_unlock(&rng->lock);
+    return 0;
+}
+
+// Key generation: the same seed gives the same key, rsa_public_key_init takes
+// the modulus and a signature made with d verifies with the public key
+static bool test_keygen(const uint8_t *firmware_data, size_t firmware_size) {
+    static rsa_private_key_t key, again;
+    test_rng_t rng = { PTHREAD_MUTEX_INITIALIZER, 0 };
+    rsa_public_key_t pub;
+    uint8_t signature[RSA_MAX_MODULUS_BYTES];
+    uint8_t message[64];
+    bool ok = rsa_generate_key(&key, RSA_KEYGEN_MIN_BITS, 65537, 1, test_rng, &rng) == RSA_KEYGEN_OK;
+    rng.counter = 0;
+    ok = ok && rsa_generate_key(&again, RSA_KEYGEN_MIN_BITS, 65537, 1, test_rng, &rng) == RSA_KEYGEN_OK &&
+         key.mod_len == RSA_KEYGEN_MIN_BITS / 8 &&
+         memcmp(key.modulus, again.modulus, key.mod_len) == 0 &&
+         memcmp(key.private_exponent, again.private_exponent, key.mod_len) == 0;
+    if (!ok) {
+        printf("[FAIL] Keygen: %d-bit key not generated, or not the same from the same seed\n",
+               RSA_KEYGEN_MIN_BITS);
+        return false;
+    }
+    if (rsa_public_key_init(&pub, key.modulus, key.mod_len, key.exponent) != RSA_VERIFY_OK ||
+        pub.bits != RSA_KEYGEN_MIN_BITS) {
+        printf("[FAIL] Keygen: rsa_public_key_init rejected the generated modulus\n");
+        return false;
+    }
+
+    // The firmware image (SHA-256) and a short message (SHA-512); a changed byte must fail
+    memset(message, 0xA5, sizeof(message));
+    ok = rsa_private_key_sign(&key, RSA_HASH_SHA256, firmware_data, firmware_size, signature) == RSA_KEYGEN_OK &&
+         rsa_verify_with_key(&pub, firmware_data, firmware_size, signature, key.mod_len) == RSA_VERIFY_OK &&
+         rsa_private_key_sign(&key, RSA_HASH_SHA512, message, sizeof(message), signature) == RSA_KEYGEN_OK &&
+         rsa_verify_with_key(&pub, message, sizeof(message), signature, key.mod_len) == RSA_VERIFY_OK;
+    message[17] ^= 0x01;
+    ok = ok && rsa_verify_with_key(&pub, message, sizeof(message), signature, key.mod_len) == RSA_VERIFY_INVALID_SIGNATURE;
+    if (!ok) {
+        printf("[FAIL] Keygen: signature made with d does not verify with the public key\n");
+        return false;
+    }
+    printf("[SUCCESS] Keygen: deterministic %d-bit key, signed with d, verified with n/e\n",
+           RSA_KEYGEN_MIN_BITS);
+    return true;
+}
 
 int main() {
     printf("[INFO] Opening firmware.bin...\n");
@@ -82,6 +382,154 @@ int main() {
             break;
     }
 
+    // Same check streamed from the file in 4 KB blocks, without the whole image in memory
+    printf("[INFO] Verifying firmware signature while streaming firmware.bin...\n");
+    rsa_public_key_t key;
+    rsa_verify_ctx_t stream;
+    rsa_verify_result_t stream_result = rsa_public_key_init(&key, rsa_modulus, RSA_KEY_SIZE, rsa_exponent);
+    f = fopen("./genkey/firmware.bin", "rb");
+    if (stream_result == RSA_VERIFY_OK && f && rsa_verify_init(&stream, &key) == RSA_VERIFY_OK) {
+        uint8_t block[4096];
+        size_t n;
+        while ((n = fread(block, 1, sizeof(block), f)) > 0) {
+            rsa_verify_update(&stream, block, n);
+        }
+        stream_result = rsa_verify_final(&stream, firmware_signature, SIGNATURE_SIZE);
+    } else {
+        stream_result = RSA_VERIFY_ERROR;
+    }
+    if (f) fclose(f);
+    if (stream_result == RSA_VERIFY_OK) {
+        printf("[SUCCESS] Streamed verification is VALID\n");
+    } else {
+        printf("[FAIL] Streamed verification failed: %d\n", stream_result);
+        result = stream_result;
+    }
+
+    // Checkpoint after the first half, then resume and hash only the rest
+    rsa_verify_ctx_t resumed;
+    uint8_t checkpoint[SHA256_CHECKPOINT_SIZE];
+    uint64_t offset = 0;
+    rsa_verify_result_t resume_result = rsa_verify_init(&stream, &key);
+    if (resume_result == RSA_VERIFY_OK) {
+        rsa_verify_update(&stream, firmware_data, firmware_size / 2);
+        resume_result = rsa_verify_checkpoint(&stream, checkpoint);
+    }
+    if (resume_result == RSA_VERIFY_OK) {
+        resume_result = rsa_verify_resume(&resumed, &key, checkpoint, &offset);
+    }
+    if (resume_result == RSA_VERIFY_OK) {
+        rsa_verify_update(&resumed, firmware_data + offset, firmware_size - offset);
+        resume_result = rsa_verify_final(&resumed, firmware_signature, SIGNATURE_SIZE);
+    }
+    if (resume_result == RSA_VERIFY_OK) {
+        printf("[SUCCESS] Verification resumed at byte %llu is VALID\n", (unsigned long long)offset);
+    } else {
+        printf("[FAIL] Resumed verification failed: %d\n", resume_result);
+        result = resume_result;
+    }
+
+    // Library file verification in both I/O modes, with their throughput
+    static const struct { rsa_file_io_t mode; const char *name; } file_modes[] = {
+        { RSA_FILE_IO_MMAP, "mmap" },
+        { RSA_FILE_IO_THREADED, "double-buffered reader" },
+    };
+    for (size_t m = 0; m < sizeof(file_modes) / sizeof(file_modes[0]); m++) {
+        rsa_file_stats_t stats;
+        rsa_verify_result_t file_result = rsa_verify_file("./genkey/firmware.bin", &key,
+                                                          firmware_signature, SIGNATURE_SIZE,
+                                                          file_modes[m].mode, &stats);
+        if (file_result == RSA_VERIFY_OK) {
+            printf("[SUCCESS] rsa_verify_file (%s) is VALID: %llu bytes, %.1f MB/s\n", file_modes[m].name,
+                   (unsigned long long)stats.bytes, stats.bytes_per_sec / 1e6);
+        } else {
+            printf("[FAIL] rsa_verify_file (%s) failed: %d\n", file_modes[m].name, file_result);
+            result = file_result;
+        }
+    }
+
+    // SHA-512 signature of the same image, when generate_keys.sh produced one
+    size_t sha512_sig_len;
+    uint8_t *sha512_sig = read_file("./genkey/firmware_sha512.sig", &sha512_sig_len);
+    if (sha512_sig) {
+        rsa_verify_result_t sha512_result = rsa_verify_with_key(&key, firmware_data, firmware_size,
+                                                                sha512_sig, sha512_sig_len);
+        if (sha512_result == RSA_VERIFY_OK) {
+            printf("[SUCCESS] SHA-512 firmware signature is VALID\n");
+        } else {
+            printf("[FAIL] SHA-512 firmware signature failed: %d\n", sha512_result);
+            result = sha512_result;
+        }
+        free(sha512_sig);
+    }
+
+    if (!test_sha256_many(firmware_data, firmware_size)) {
+        result = RSA_VERIFY_ERROR;
+    }
+    if (!test_keyring(firmware_data, firmware_size)) {
+        result = RSA_VERIFY_ERROR;
+    }
+    if (!test_keygen(firmware_data, firmware_size)) {
+        result = RSA_VERIFY_ERROR;
+    }
+
+#ifndef _WIN32
+    if (!test_cache(&key, firmware_data, firmware_size)) {
+        result = RSA_VERIFY_ERROR;
+    }
+#endif
+
+    if (!test_verify_batch(&key, firmware_data, firmware_size)) {
+        result = RSA_VERIFY_ERROR;
+    }
+
+    // Thread-pool batch: the firmware signature as 16 jobs, the last one with a wrong signature
+    rsa_verify_pool_t pool;
+    rsa_verify_job_t jobs[16];
+    rsa_verify_result_t job_results[16];
+    uint8_t bad_signature[SIGNATURE_SIZE];
+    memcpy(bad_signature, firmware_signature, SIGNATURE_SIZE);
+    bad_signature[SIGNATURE_SIZE / 2] ^= 0x01;
+    for (size_t i = 0; i < 16; i++) {
+        jobs[i] = (rsa_verify_job_t){ &key, firmware_data, firmware_size,
+                                      (i == 15) ? bad_signature : firmware_signature, SIGNATURE_SIZE };
+    }
+    if (rsa_verify_pool_init(&pool, 0) == RSA_VERIFY_OK) {
+        rsa_verify_batch(&pool, jobs, job_results, 16);
+        size_t valid = 0;
+        for (size_t i = 0; i < 15; i++) valid += (job_results[i] == RSA_VERIFY_OK);
+        if (valid == 15 && job_results[15] != RSA_VERIFY_OK) {
+            printf("[SUCCESS] Batch on %u threads: 15 valid, tampered job rejected (%d)\n",
+                   pool.threads, job_results[15]);
+        } else {
+            printf("[FAIL] Batch verification: %zu of 15 valid, tampered job %d\n", valid, job_results[15]);
+            result = RSA_VERIFY_ERROR;
+        }
+        rsa_verify_pool_free(&pool);
+    }
+
+    // Chunked manifest, when generate_keys.sh produced one
+    size_t manifest_len, manifest_sig_len;
+    uint8_t *manifest = read_file("./genkey/manifest.bin", &manifest_len);
+    uint8_t *manifest_sig = read_file("./genkey/manifest.sig", &manifest_sig_len);
+    if (manifest && manifest_sig) {
+        printf("[INFO] Verifying firmware against manifest.bin...\n");
+        rsa_verify_result_t manifest_result = verify_firmware_manifest(
+            firmware_data, firmware_size,
+            manifest, manifest_len,
+            manifest_sig, manifest_sig_len,
+            0
+        );
+        if (manifest_result == RSA_VERIFY_OK) {
+            printf("[SUCCESS] Firmware matches the signed manifest\n");
+        } else {
+            printf("[FAIL] Manifest verification failed: %d\n", manifest_result);
+            result = manifest_result;
+        }
+    }
+    free(manifest);
+    free(manifest_sig);
+
     free(firmware_data);
     return (result == RSA_VERIFY_OK) ? 0 : 1;
 }